@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/AssetBatchDuplicator.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetToolsModule.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "DebugHeader.h"
+
+int32 FAssetBatchDuplicator::DuplicateAssets(const TArray<FAssetData>& SourceAssetsData, int32 DuplicatesNum)
+{
+	if (SourceAssetsData.Num() == 0 || DuplicatesNum <= 0)
+	{
+		return 0;
+	}
+
+	TSet<FName> TakenPackageNames = CollectTakenPackageNames(SourceAssetsData);
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+
+	FScopedSlowTask DuplicationTask(SourceAssetsData.Num(), FText::FromString(TEXT("Duplicating assets")));
+	DuplicationTask.MakeDialog(true);
+
+	TArray<UPackage*> NewPackages;
+	NewPackages.Reserve(SourceAssetsData.Num() * DuplicatesNum);
+	for (const FAssetData& SourceAssetData : SourceAssetsData)
+	{
+		if (DuplicationTask.ShouldCancel())
+		{
+			break;
+		}
+		DuplicationTask.EnterProgressFrame(1.f, FText::FromName(SourceAssetData.AssetName));
+
+		UObject* SourceAsset = SourceAssetData.GetAsset();
+		if (!SourceAsset)
+		{
+			continue;
+		}
+
+		const FString SourceAssetName = SourceAssetData.AssetName.ToString();
+		const FString PackagePath = SourceAssetData.PackagePath.ToString();
+		int32 Suffix = 0;
+		for (int32 CopyIndex = 0; CopyIndex < DuplicatesNum; ++CopyIndex)
+		{
+			// Taken names are skipped rather than failing the copy, so every copy gets made
+			FString NewAssetName;
+			FName NewPackageName;
+			do
+			{
+				NewAssetName = SourceAssetName + TEXT("_") + FString::FromInt(++Suffix);
+				NewPackageName = FName(PackagePath / NewAssetName);
+			}
+			while (TakenPackageNames.Contains(NewPackageName));
+			TakenPackageNames.Add(NewPackageName);
+
+			if (UObject* NewAsset = AssetTools.DuplicateAsset(NewAssetName, PackagePath, SourceAsset))
+			{
+				NewPackages.Add(NewAsset->GetPackage());
+			}
+		}
+	}
+
+	return SaveNewPackages(NewPackages);
+}
+
+TSet<FName> FAssetBatchDuplicator::CollectTakenPackageNames(const TArray<FAssetData>& SourceAssetsData)
+{
+	TSet<FName> PackagePaths;
+	for (const FAssetData& SourceAssetData : SourceAssetsData)
+	{
+		PackagePaths.Add(SourceAssetData.PackagePath);
+	}
+
+	// One registry query per destination folder instead of one existence check per copy; unsaved assets take their names too
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	TSet<FName> TakenPackageNames;
+	TArray<FAssetData> AssetsDataInFolder;
+	for (const FName& PackagePath : PackagePaths)
+	{
+		AssetsDataInFolder.Reset();
+		AssetRegistry.GetAssetsByPath(PackagePath, AssetsDataInFolder, false, false);
+		for (const FAssetData& AssetDataInFolder : AssetsDataInFolder)
+		{
+			TakenPackageNames.Add(AssetDataInFolder.PackageName);
+		}
+	}
+	return TakenPackageNames;
+}
+
+int32 FAssetBatchDuplicator::SaveNewPackages(const TArray<UPackage*>& NewPackages)
+{
+	FScopedSlowTask SaveTask(NewPackages.Num(), FText::FromString(TEXT("Saving duplicated assets")));
+	SaveTask.MakeDialog();
+
+	// Each package is serialized here while the previous ones are still being written out
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_Async;
+	// A failed save is reported below rather than raised as a fatal error
+	SaveArgs.Error = GWarn;
+
+	TArray<FString> SavedFilenames;
+	for (UPackage* NewPackage : NewPackages)
+	{
+		SaveTask.EnterProgressFrame();
+
+		const FString PackageFilename = FPackageName::LongPackageNameToFilename(
+			NewPackage->GetName(),
+			NewPackage->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension()
+		);
+		if (UPackage::SavePackage(NewPackage, NewPackage->FindAssetInPackage(), *PackageFilename, SaveArgs))
+		{
+			SavedFilenames.Add(FPaths::ConvertRelativePathToFull(PackageFilename));
+		}
+		else
+		{
+			DebugHeader::PrintLog(TEXT("Failed to save ") + NewPackage->GetName());
+		}
+	}
+
+	UPackage::WaitForAsyncFileWrites();
+
+	// Saving through UPackage skips the editor save path that marks new files for add, so they are added here in one batch
+	if (SavedFilenames.Num() > 0 && ISourceControlModule::Get().IsEnabled())
+	{
+		if (!USourceControlHelpers::MarkFilesForAdd(SavedFilenames, true))
+		{
+			DebugHeader::PrintLog(TEXT("Failed to mark the duplicated files for add in source control"));
+		}
+	}
+	return SavedFilenames.Num();
+}
@@ -0,0 +1,444 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/AssetDeletionEngine.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "SuperManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Settings/SuperManagerSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ObjectTools.h"
+#include "DebugHeader.h"
+
+namespace AssetDeletionJournal
+{
+	// Each line is one package: '+' when queued, '-' once it is gone from the registry
+	const TCHAR* PendingPrefix = TEXT("+");
+	const TCHAR* ProcessedPrefix = TEXT("-");
+}
+
+void FAssetDeletionEngine::Initialize()
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.OnFilesLoaded().AddRaw(this, &FAssetDeletionEngine::OnAssetRegistryFilesLoaded);
+	}
+	else
+	{
+		OnAssetRegistryFilesLoaded();
+	}
+}
+
+void FAssetDeletionEngine::Shutdown()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnFilesLoaded().RemoveAll(this);
+	}
+	if (ResumePromptTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ResumePromptTickerHandle);
+		ResumePromptTickerHandle.Reset();
+	}
+}
+
+int32 FAssetDeletionEngine::DeleteAssets(const TArray<FAssetData>& AssetsToDelete, bool bShowConfirmation)
+{
+	if (AssetsToDelete.Num() == 0 || bDeletionInProgress)
+	{
+		return 0;
+	}
+
+	const int32 ChunkSize = GetDefault<USuperManagerSettings>()->DeletionChunkSize;
+	if (AssetsToDelete.Num() <= ChunkSize)
+	{
+		return ObjectTools::DeleteAssets(AssetsToDelete, bShowConfirmation);
+	}
+
+	if (bShowConfirmation)
+	{
+		EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(
+			EAppMsgType::YesNo,
+			TEXT("Delete ") + FString::FromInt(AssetsToDelete.Num()) +
+			TEXT(" assets in chunks of ") + FString::FromInt(ChunkSize) + TEXT("?"),
+			false
+		);
+		if (ConfirmResult == EAppReturnType::No)
+		{
+			return 0;
+		}
+	}
+
+	DeleteJournal();
+	AppendToJournal(AssetDeletionJournal::PendingPrefix, AssetsToDelete);
+	return RunChunkedDeletion(AssetsToDelete);
+}
+
+bool FAssetDeletionEngine::HasInterruptedRun() const
+{
+	return IFileManager::Get().FileExists(*GetJournalFilePath());
+}
+
+int32 FAssetDeletionEngine::ResumeInterruptedRun()
+{
+	if (bDeletionInProgress)
+	{
+		return 0;
+	}
+
+	// Packages deleted before the interruption are simply no longer in the registry
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	TArray<FAssetData> AssetsToDelete;
+	for (const FName& PackageName : ReadPendingPackagesFromJournal())
+	{
+		AssetRegistry.GetAssetsByPackageName(PackageName, AssetsToDelete);
+	}
+
+	if (AssetsToDelete.Num() == 0)
+	{
+		DeleteJournal();
+		return 0;
+	}
+	return RunChunkedDeletion(AssetsToDelete);
+}
+
+int32 FAssetDeletionEngine::RunChunkedDeletion(const TArray<FAssetData>& AssetsToDelete)
+{
+	TGuardValue<bool> DeletionGuard(bDeletionInProgress, true);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const int32 ChunkSize = GetDefault<USuperManagerSettings>()->DeletionChunkSize;
+
+	FScopedSlowTask DeletionTask(AssetsToDelete.Num(), FText::FromString(TEXT("Deleting assets")));
+	DeletionTask.MakeDialog(true);
+
+	int32 NumDeleted = 0;
+	bool bCancelled = false;
+	TArray<FAssetData> AssetsToProcess = AssetsToDelete;
+	for (int32 PassIndex = 0; AssetsToProcess.Num() > 0 && !bCancelled; ++PassIndex)
+	{
+		const TArray<TArray<FAssetData>> Chunks = BuildChunksReferencersFirst(AssetsToProcess, ChunkSize);
+		const int32 NumDeletedBeforePass = NumDeleted;
+		TArray<FAssetData> SkippedAssets;
+		TArray<FAssetData> DeletedAssets;
+		for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+		{
+			if (DeletionTask.ShouldCancel())
+			{
+				bCancelled = true;
+				break;
+			}
+
+			const TArray<FAssetData>& Chunk = Chunks[ChunkIndex];
+			const double ChunkStartTime = FPlatformTime::Seconds();
+			ObjectTools::DeleteAssets(Chunk, false);
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			const double ChunkSeconds = FMath::Max(FPlatformTime::Seconds() - ChunkStartTime, UE_DOUBLE_SMALL_NUMBER);
+
+			// ObjectTools skips assets that are still referenced without saying so; only packages gone from the registry count
+			DeletedAssets.Reset();
+			TArray<FAssetData> RemainingAssets;
+			for (const FAssetData& AssetData : Chunk)
+			{
+				RemainingAssets.Reset();
+				AssetRegistry.GetAssetsByPackageName(AssetData.PackageName, RemainingAssets);
+				if (RemainingAssets.Num() == 0)
+				{
+					DeletedAssets.Add(AssetData);
+				}
+				else
+				{
+					SkippedAssets.Add(AssetData);
+				}
+			}
+			NumDeleted += DeletedAssets.Num();
+			AppendToJournal(AssetDeletionJournal::ProcessedPrefix, DeletedAssets);
+
+			const FString ChunkReport = FString::Printf(
+				TEXT("Pass %d, chunk %d/%d: deleted %d/%d assets in %.2fs (%.1f assets/s)"),
+				PassIndex + 1, ChunkIndex + 1, Chunks.Num(), DeletedAssets.Num(), Chunk.Num(), ChunkSeconds, DeletedAssets.Num() / ChunkSeconds
+			);
+			DebugHeader::PrintLog(ChunkReport);
+			DeletionTask.EnterProgressFrame(PassIndex == 0 ? Chunk.Num() : 0.f, FText::FromString(ChunkReport));
+		}
+
+		// A skipped asset may have been held only by an asset that went later in the same pass, so retry while passes still delete something
+		if (NumDeleted == NumDeletedBeforePass)
+		{
+			break;
+		}
+		AssetsToProcess = MoveTemp(SkippedAssets);
+	}
+
+	// A cancelled run was stopped on purpose, so there is nothing to offer for resume
+	DeleteJournal();
+
+	const int32 NumNotDeleted = AssetsToDelete.Num() - NumDeleted;
+	DebugHeader::ShowNotifyInfo(
+		TEXT("Deleted ") + FString::FromInt(NumDeleted) + TEXT(" of ") + FString::FromInt(AssetsToDelete.Num()) +
+		(bCancelled ? TEXT(" assets (cancelled)") :
+		NumNotDeleted > 0 ? TEXT(" assets (") + FString::FromInt(NumNotDeleted) + TEXT(" still referenced)") : FString(TEXT(" assets")))
+	);
+	return NumDeleted;
+}
+
+TArray<TArray<FAssetData>> FAssetDeletionEngine::BuildChunksReferencersFirst(const TArray<FAssetData>& AssetsToDelete, int32 ChunkSize)
+{
+	// One node per package, with edges only to dependencies inside the set
+	TArray<FName> PackageNames;
+	TMap<FName, int32> PackageIndices;
+	TArray<TArray<FAssetData>> PackageAssets;
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		int32 PackageIndex;
+		if (const int32* ExistingIndex = PackageIndices.Find(AssetData.PackageName))
+		{
+			PackageIndex = *ExistingIndex;
+		}
+		else
+		{
+			PackageIndex = PackageNames.Add(AssetData.PackageName);
+			PackageIndices.Add(AssetData.PackageName, PackageIndex);
+			PackageAssets.AddDefaulted();
+		}
+		PackageAssets[PackageIndex].Add(AssetData);
+	}
+	const int32 NumPackages = PackageNames.Num();
+
+	// The session index when it is available, otherwise the registry for just these packages
+	FSuperManagerModule* SuperManager = FModuleManager::GetModulePtr<FSuperManagerModule>(TEXT("SuperManager"));
+	const FAssetReferenceIndex* ReferenceIndex = SuperManager ? SuperManager->GetReferenceIndexIfIdle() : nullptr;
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<int32> EdgeOffsets;
+	TArray<int32> Edges;
+	EdgeOffsets.Reserve(NumPackages + 1);
+	TArray<FName> RegistryDependencies;
+	for (const FName& PackageName : PackageNames)
+	{
+		EdgeOffsets.Add(Edges.Num());
+
+		const TArray<FName>* Dependencies = nullptr;
+		if (ReferenceIndex)
+		{
+			Dependencies = ReferenceIndex->GetPackageDependencies().Find(PackageName);
+		}
+		else
+		{
+			RegistryDependencies.Reset();
+			AssetRegistry.GetDependencies(PackageName, RegistryDependencies, UE::AssetRegistry::EDependencyCategory::Package);
+			Dependencies = &RegistryDependencies;
+		}
+
+		if (Dependencies)
+		{
+			for (const FName& Dependency : *Dependencies)
+			{
+				if (const int32* DependencyIndex = PackageIndices.Find(Dependency))
+				{
+					Edges.Add(*DependencyIndex);
+				}
+			}
+		}
+	}
+	EdgeOffsets.Add(Edges.Num());
+
+	// Iterative Tarjan: components come out dependencies-first, and each reference cycle is one component
+	TArray<int32> VisitOrders;
+	TArray<int32> LowLinks;
+	TArray<bool> OnStack;
+	VisitOrders.Init(INDEX_NONE, NumPackages);
+	LowLinks.Init(INDEX_NONE, NumPackages);
+	OnStack.Init(false, NumPackages);
+
+	TArray<int32> ComponentStack;
+	TArray<TPair<int32, int32>> VisitStack;
+	TArray<TArray<int32>> Components;
+	int32 NextVisitOrder = 0;
+
+	auto Visit = [&](int32 PackageIndex)
+	{
+		VisitOrders[PackageIndex] = LowLinks[PackageIndex] = NextVisitOrder++;
+		ComponentStack.Push(PackageIndex);
+		OnStack[PackageIndex] = true;
+		VisitStack.Emplace(PackageIndex, EdgeOffsets[PackageIndex]);
+	};
+
+	for (int32 StartIndex = 0; StartIndex < NumPackages; ++StartIndex)
+	{
+		if (VisitOrders[StartIndex] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Visit(StartIndex);
+		while (VisitStack.Num() > 0)
+		{
+			const int32 PackageIndex = VisitStack.Last().Key;
+			int32& EdgeIndex = VisitStack.Last().Value;
+			if (EdgeIndex < EdgeOffsets[PackageIndex + 1])
+			{
+				const int32 DependencyIndex = Edges[EdgeIndex++];
+				if (VisitOrders[DependencyIndex] == INDEX_NONE)
+				{
+					Visit(DependencyIndex);
+				}
+				else if (OnStack[DependencyIndex])
+				{
+					LowLinks[PackageIndex] = FMath::Min(LowLinks[PackageIndex], VisitOrders[DependencyIndex]);
+				}
+				continue;
+			}
+
+			VisitStack.Pop(EAllowShrinking::No);
+			if (LowLinks[PackageIndex] == VisitOrders[PackageIndex])
+			{
+				TArray<int32>& Component = Components.AddDefaulted_GetRef();
+				int32 ComponentIndex;
+				do
+				{
+					ComponentIndex = ComponentStack.Pop(EAllowShrinking::No);
+					OnStack[ComponentIndex] = false;
+					Component.Add(ComponentIndex);
+				}
+				while (ComponentIndex != PackageIndex);
+			}
+			if (VisitStack.Num() > 0)
+			{
+				const int32 ReferencerIndex = VisitStack.Last().Key;
+				LowLinks[ReferencerIndex] = FMath::Min(LowLinks[ReferencerIndex], LowLinks[PackageIndex]);
+			}
+		}
+	}
+
+	// Referencers first, so each chunk only holds assets nothing left outside it still references; a cycle is never split
+	TArray<TArray<FAssetData>> Chunks;
+	for (int32 ComponentIndex = Components.Num() - 1; ComponentIndex >= 0; --ComponentIndex)
+	{
+		int32 ComponentAssetNum = 0;
+		for (const int32 PackageIndex : Components[ComponentIndex])
+		{
+			ComponentAssetNum += PackageAssets[PackageIndex].Num();
+		}
+
+		if (Chunks.Num() == 0 || (Chunks.Last().Num() > 0 && Chunks.Last().Num() + ComponentAssetNum > ChunkSize))
+		{
+			Chunks.AddDefaulted();
+		}
+		for (const int32 PackageIndex : Components[ComponentIndex])
+		{
+			Chunks.Last().Append(PackageAssets[PackageIndex]);
+		}
+	}
+	return Chunks;
+}
+
+void FAssetDeletionEngine::OnAssetRegistryFilesLoaded()
+{
+	if (!HasInterruptedRun())
+	{
+		return;
+	}
+
+	// Wait a frame so the prompt doesn't open in the middle of the registry broadcast
+	ResumePromptTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+		{
+			ResumePromptTickerHandle.Reset();
+			const int32 NumPending = ReadPendingPackagesFromJournal().Num();
+			if (NumPending == 0)
+			{
+				DeleteJournal();
+				return false;
+			}
+
+			EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(
+				EAppMsgType::YesNo,
+				TEXT("A previous bulk deletion was interrupted with ") + FString::FromInt(NumPending) +
+				TEXT(" packages left.\nWould you like to resume it?"),
+				false
+			);
+
+			if (ConfirmResult == EAppReturnType::Yes)
+			{
+				ResumeInterruptedRun();
+			}
+			else
+			{
+				DeleteJournal();
+			}
+			return false;
+		}
+	));
+}
+
+FString FAssetDeletionEngine::GetJournalFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("DeletionJournal.txt");
+}
+
+void FAssetDeletionEngine::AppendToJournal(const TCHAR* Prefix, const TArray<FAssetData>& AssetsData)
+{
+	FString JournalLines;
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		JournalLines += Prefix;
+		JournalLines += AssetData.PackageName.ToString();
+		JournalLines += LINE_TERMINATOR;
+	}
+
+	FFileHelper::SaveStringToFile(
+		JournalLines,
+		*GetJournalFilePath(),
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+		&IFileManager::Get(),
+		FILEWRITE_Append
+	);
+}
+
+TArray<FName> FAssetDeletionEngine::ReadPendingPackagesFromJournal()
+{
+	TArray<FString> JournalLines;
+	FFileHelper::LoadFileToStringArray(JournalLines, *GetJournalFilePath());
+
+	TArray<FName> PendingPackages;
+	TSet<FName> QueuedPackages;
+	TSet<FName> ProcessedPackages;
+	for (const FString& JournalLine : JournalLines)
+	{
+		if (JournalLine.Len() < 2)
+		{
+			continue;
+		}
+
+		const FName PackageName(*JournalLine.RightChop(1));
+		if (JournalLine.StartsWith(AssetDeletionJournal::PendingPrefix))
+		{
+			bool bAlreadyQueued = false;
+			QueuedPackages.Add(PackageName, &bAlreadyQueued);
+			if (!bAlreadyQueued)
+			{
+				PendingPackages.Add(PackageName);
+			}
+		}
+		else if (JournalLine.StartsWith(AssetDeletionJournal::ProcessedPrefix))
+		{
+			ProcessedPackages.Add(PackageName);
+		}
+	}
+
+	PendingPackages.RemoveAll([&ProcessedPackages](const FName& PackageName)
+		{
+			return ProcessedPackages.Contains(PackageName);
+		}
+	);
+	return PendingPackages;
+}
+
+void FAssetDeletionEngine::DeleteJournal()
+{
+	IFileManager::Get().Delete(*GetJournalFilePath(), false, false, true);
+}
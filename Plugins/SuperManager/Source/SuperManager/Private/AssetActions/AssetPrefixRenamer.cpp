@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/AssetPrefixRenamer.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetToolsModule.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "SuperManager.h"
+#include "DebugHeader.h"
+
+FAssetPrefixRenamer::FAssetPrefixRenamer(const TMap<UObject*, FString>& PrefixMap)
+	: MaterialClassPath(UMaterial::StaticClass()->GetClassPathName())
+	, MaterialInstanceConstantClassPath(UMaterialInstanceConstant::StaticClass()->GetClassPathName())
+{
+	for (const TPair<UObject*, FString>& PrefixPair : PrefixMap)
+	{
+		if (const UClass* PrefixClass = Cast<UClass>(PrefixPair.Key))
+		{
+			PrefixByClassPath.Add(PrefixClass->GetClassPathName(), PrefixPair.Value);
+		}
+	}
+}
+
+const FString* FAssetPrefixRenamer::FindPrefix(const FTopLevelAssetPath& ClassPath)
+{
+	if (const FString* const* CachedPrefix = ResolvedPrefixCache.Find(ClassPath))
+	{
+		return *CachedPrefix;
+	}
+
+	// The class itself first, then its ancestors from the nearest one up
+	const FString* Prefix = PrefixByClassPath.Find(ClassPath);
+	if (!Prefix)
+	{
+		for (const FTopLevelAssetPath& AncestorClassPath : GetAncestorClassPaths(ClassPath))
+		{
+			Prefix = PrefixByClassPath.Find(AncestorClassPath);
+			if (Prefix)
+			{
+				break;
+			}
+		}
+	}
+	if (Prefix && Prefix->IsEmpty())
+	{
+		Prefix = nullptr;
+	}
+	return ResolvedPrefixCache.Add(ClassPath, Prefix);
+}
+
+bool FAssetPrefixRenamer::IsMaterialInstanceClass(const FTopLevelAssetPath& ClassPath)
+{
+	return IsChildOf(ClassPath, MaterialInstanceConstantClassPath);
+}
+
+FString FAssetPrefixRenamer::GetPrefixedName(const FAssetData& AssetData, const FString& Prefix)
+{
+	return MakePrefixedName(AssetData.AssetName.ToString(), Prefix, IsMaterialInstanceClass(AssetData.AssetClassPath));
+}
+
+FString FAssetPrefixRenamer::MakePrefixedName(const FString& AssetName, const FString& Prefix, bool bIsMaterialInstance) const
+{
+	FString NewName = AssetName;
+	if (bIsMaterialInstance)
+	{
+		if (const FString* MaterialPrefix = PrefixByClassPath.Find(MaterialClassPath))
+		{
+			NewName.RemoveFromStart(*MaterialPrefix);
+		}
+		NewName.RemoveFromEnd(TEXT("_Inst"));
+	}
+	return Prefix + NewName;
+}
+
+int32 FAssetPrefixRenamer::AddPrefixes(const TArray<FAssetData>& AssetsData, FSimpleDelegate OnCompleted)
+{
+	TArray<FAssetRenameData> AssetsToRename;
+	TSet<FName> ScopePackageNames;
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		const FString* PrefixFound = FindPrefix(AssetData);
+		if (!PrefixFound)
+		{
+			DebugHeader::Print(TEXT("Failed to find prefix for class") + AssetData.AssetClassPath.GetAssetName().ToString(), FColor::Red);
+			continue;
+		}
+
+		const FString OldName = AssetData.AssetName.ToString();
+		if (OldName.StartsWith(*PrefixFound))
+		{
+			DebugHeader::Print(OldName + TEXT(" alreay has prefix added"), FColor::Red);
+			continue;
+		}
+
+		const FString PackagePath = AssetData.PackagePath.ToString();
+		const FString NewName = GetPrefixedName(AssetData, *PrefixFound);
+		AssetsToRename.Emplace(
+			AssetData.GetSoftObjectPath(),
+			FSoftObjectPath(FTopLevelAssetPath(FName(PackagePath / NewName), FName(NewName)))
+		);
+		ScopePackageNames.Add(AssetData.PackageName);
+		ScopePackageNames.Add(FName(PackagePath / NewName));
+	}
+
+	if (AssetsToRename.Num() == 0)
+	{
+		OnCompleted.ExecuteIfBound();
+		return 0;
+	}
+
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+	if (!AssetTools.RenameAssets(AssetsToRename))
+	{
+		DebugHeader::PrintLog(TEXT("Some assets could not be renamed"));
+	}
+
+	// The batch can fail part way, so only assets that now exist under their new name are counted
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	int32 NumRenamed = 0;
+	for (const FAssetRenameData& AssetToRename : AssetsToRename)
+	{
+		if (AssetRegistry.GetAssetByObjectPath(AssetToRename.NewObjectPath).IsValid())
+		{
+			++NumRenamed;
+		}
+	}
+
+	// One fixup pass for every redirector the batch left at the old names
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManager.GetRedirectorFixupService().FixUpRedirectors(ScopePackageNames, TArray<FString>(), OnCompleted);
+	return NumRenamed;
+}
+
+bool FAssetPrefixRenamer::IsChildOf(const FTopLevelAssetPath& ClassPath, const FTopLevelAssetPath& ParentClassPath)
+{
+	return ClassPath == ParentClassPath || GetAncestorClassPaths(ClassPath).Contains(ParentClassPath);
+}
+
+const TArray<FTopLevelAssetPath>& FAssetPrefixRenamer::GetAncestorClassPaths(const FTopLevelAssetPath& ClassPath)
+{
+	if (const TArray<FTopLevelAssetPath>* CachedAncestorClassPaths = AncestorClassPathCache.Find(ClassPath))
+	{
+		return *CachedAncestorClassPaths;
+	}
+
+	TArray<FTopLevelAssetPath> AncestorClassPaths;
+	IAssetRegistry::GetChecked().GetAncestorClassNames(ClassPath, AncestorClassPaths);
+	return AncestorClassPathCache.Add(ClassPath, MoveTemp(AncestorClassPaths));
+}
@@ -2,9 +2,14 @@
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "Misc/MessageDialog.h"
-#include "ObjectTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
+#include "AssetActions/AssetBatchDuplicator.h"
+#include "AssetActions/AssetPrefixRenamer.h"
+#include "AssetAnalysis/AssetReachabilityAnalyzer.h"
+#include "AssetAnalysis/AssetDiskUsage.h"
+#include "Slate/DeletionPreviewWidget.h"
+#include "SuperManager.h"
 #include "DebugHeader.h"
 
 void UQuickAssetAction::DuplicateAssets(int32 DuplicatesNum)
@@ -16,22 +21,7 @@ void UQuickAssetAction::DuplicateAssets(int32 DuplicatesNum)
 	}
 
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
-	uint32 Counter = 0;
-	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
-	{
-		for (int32 i = 0; i < DuplicatesNum; ++i)
-		{
-			const FString SourceAssetPath = SelectedAssetData.GetSoftObjectPath().ToString();
-			const FString NewDuplicatedAssetName = SelectedAssetData.AssetName.ToString() + TEXT("_") + FString::FromInt(i + 1);
-			const FString NewPathName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewDuplicatedAssetName);
-
-			if (UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
-			{
-				UEditorAssetLibrary::SaveAsset(NewPathName, false);
-				++Counter;
-			}
-		}
-	}
+	const int32 Counter = FAssetBatchDuplicator::DuplicateAssets(SelectedAssetsData, DuplicatesNum);
 
 	if (Counter > 0)
 	{
@@ -41,60 +31,75 @@ void UQuickAssetAction::DuplicateAssets(int32 DuplicatesNum)
 
 void UQuickAssetAction::AddPrefixes()
 {
-	TArray<UObject*> SelectedObjects = UEditorUtilityLibrary::GetSelectedAssets();
-	uint32 Counter = 0;
-	for (UObject* SelectedObject : SelectedObjects)
+	// Class paths come from the registry, so nothing is loaded before the rename itself
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	FAssetPrefixRenamer PrefixRenamer(PrefixMap);
+	const int32 Counter = PrefixRenamer.AddPrefixes(SelectedAssetsData);
+
+	if (Counter > 0)
 	{
-		if (!SelectedObject) continue;
-		FString* PrefixFound = PrefixMap.Find(SelectedObject->GetClass());
-		if (!PrefixFound || PrefixFound->IsEmpty())
-		{
-			DebugHeader::Print(TEXT("Failed to find prefix for class") + SelectedObject->GetClass()->GetName(), FColor::Red);
-			continue;
-		}
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(Counter) + " assets");
+	}
+}
 
-		FString OldName = SelectedObject->GetName();
+void UQuickAssetAction::RemoveUnusedAssets()
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 
-		if (OldName.StartsWith(*PrefixFound))
-		{
-			DebugHeader::Print(OldName + TEXT(" alreay has prefix added"), FColor::Red);
-			continue;
-		}
+	TSet<FName> SelectedPackageNames;
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		SelectedPackageNames.Add(SelectedAssetData.PackageName);
+	}
 
-		FString NewName = OldName;
-		if(SelectedObject->IsA< UMaterialInstanceConstant>())
-		{
-			FString* MaterialPrefix = PrefixMap.Find(UMaterial::StaticClass());
-			if (MaterialPrefix)
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+		SelectedPackageNames,
+		TArray<FString>(),
+		FSimpleDelegate::CreateWeakLambda(this, [this, SelectedAssetsData]()
 			{
-				NewName.RemoveFromStart(*MaterialPrefix);
+				RemoveUnusedAssetsFromList(SelectedAssetsData);
 			}
-			NewName.RemoveFromEnd(TEXT("_Inst"));
-		}
-		const FString NewNameWithPrefix = *PrefixFound + NewName;
+		)
+	);
+}
 
-		UEditorUtilityLibrary::RenameAsset(SelectedObject, NewNameWithPrefix);
-		++Counter;
-	}
+void UQuickAssetAction::RemoveUnusedAssetsWithDependencies()
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 
-	if (Counter > 0)
+	TSet<FName> SelectedPackageNames;
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(Counter) + " assets");
+		SelectedPackageNames.Add(SelectedAssetData.PackageName);
 	}
+
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+		SelectedPackageNames,
+		TArray<FString>(),
+		FSimpleDelegate::CreateWeakLambda(this, [this, SelectedAssetsData]()
+			{
+				RemoveUnusedAssetsFromList(SelectedAssetsData, true);
+			}
+		)
+	);
 }
 
-void UQuickAssetAction::RemoveUnusedAssets()
+void UQuickAssetAction::RemoveUnusedAssetsFromList(const TArray<FAssetData>& SelectedAssetsData, bool bIncludeOrphanedDependencies)
 {
-	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	TArray<FAssetData> UnusedAssetsData;
 
-	FixUpRedirectors();
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	if (!SuperManager.EnsureReferenceIndexIdle())
+	{
+		return;
+	}
+	const FAssetReferenceIndex& ReferenceIndex = SuperManager.GetReferenceIndex();
 
 	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		TArray<FString> AssetReferencers = 
-			UEditorAssetLibrary::FindPackageReferencersForAsset(SelectedAssetData.GetSoftObjectPath().ToString());
-		if (AssetReferencers.Num() == 0)
+		if (ReferenceIndex.HasNoReferencers(SelectedAssetData.PackageName))
 		{
 			UnusedAssetsData.Add(SelectedAssetData);
 		}
@@ -106,42 +111,42 @@ void UQuickAssetAction::RemoveUnusedAssets()
 		return;
 	}
 
-	const int32 NumOfAssetsDeleted = ObjectTools::DeleteAssets(UnusedAssetsData);
-	if (NumOfAssetsDeleted == 0)
+	if (bIncludeOrphanedDependencies)
 	{
-		return;
-	}
-
-	DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + TEXT(" unused assets")));
-
-}
-
-void UQuickAssetAction::FixUpRedirectors()
-{
-	TArray<UObjectRedirector*> RedirectorsToFixArray;
-
-	FAssetRegistryModule& AssetRegistryModule = 
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace("/Game");
-	Filter.ClassPaths.Emplace(UObjectRedirector::StaticClass());
-
-	TArray<FAssetData> OutRedirectors;
-	AssetRegistryModule.Get().GetAssets(Filter, OutRedirectors);
+		// The whole cascade is worked out on the cached graph, then previewed and deleted as one batch
+		TSet<FName> UnusedPackageNames;
+		for (const FAssetData& UnusedAssetData : UnusedAssetsData)
+		{
+			UnusedPackageNames.Add(UnusedAssetData.PackageName);
+		}
+		const TSet<FName> OrphanedDependencies = FAssetReachabilityAnalyzer::FindOrphanedDependencies(
+			ReferenceIndex,
+			UnusedPackageNames,
+			SuperManager.CollectReachabilityRoots(ReferenceIndex)
+		);
+
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+		TArray<FAssetData> OrphanedAssetsData;
+		for (const FName& OrphanedDependency : OrphanedDependencies)
+		{
+			AssetRegistry.GetAssetsByPackageName(OrphanedDependency, OrphanedAssetsData, true);
+		}
 
-	for (const FAssetData& RedirectorData : OutRedirectors)
-	{
-		UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset());
-		if (RedirectorToFix)
+		UnusedPackageNames.Append(OrphanedDependencies);
+		if (!SDeletionPreviewWidget::ShowModal(UnusedAssetsData, OrphanedAssetsData, FAssetDiskUsage::GetTotalDiskSize(UnusedPackageNames)))
 		{
-			RedirectorsToFixArray.Add(RedirectorToFix);
+			return;
 		}
+		// The deletion engine orders its chunks referencers-first, so each orphan goes after the assets that held it
+		UnusedAssetsData.Append(OrphanedAssetsData);
+	}
 
+	const int32 NumOfAssetsDeleted = SuperManager.GetAssetDeletionEngine().DeleteAssets(UnusedAssetsData, !bIncludeOrphanedDependencies);
+	if (NumOfAssetsDeleted == 0)
+	{
+		return;
 	}
 
-	FAssetToolsModule& AssettoolsModule = 
-		FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + TEXT(" unused assets")));
 
-	AssettoolsModule.Get().FixupReferencers(RedirectorsToFixArray);
 }
@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/RedirectorFixupService.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "UObject/ObjectRedirector.h"
+
+namespace RedirectorFixup
+{
+	constexpr int32 LoadBatchSize = 32;
+
+	static bool IsUnderAnyFolder(FName PackageName, const TArray<FString>& FolderPaths)
+	{
+		if (FolderPaths.Num() == 0)
+		{
+			return false;
+		}
+		const FString PackageNameString = PackageName.ToString();
+		for (const FString& FolderPath : FolderPaths)
+		{
+			if (PackageNameString.StartsWith(FolderPath) &&
+				(PackageNameString.Len() == FolderPath.Len() || PackageNameString[FolderPath.Len()] == TEXT('/')))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+void FRedirectorFixupService::Initialize()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FRedirectorFixupService::OnRedirectorAssetChanged);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FRedirectorFixupService::OnRedirectorAssetChanged);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FRedirectorFixupService::OnRedirectorAssetRenamed);
+}
+
+void FRedirectorFixupService::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	LoadHandles.Empty();
+	PendingRequests.Empty();
+	bRequestInProgress = false;
+}
+
+void FRedirectorFixupService::FixUpRedirectors(
+	const TSet<FName>& ScopePackageNames,
+	const TArray<FString>& ScopeFolderPaths,
+	FSimpleDelegate OnCompleted
+)
+{
+	FFixupRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.ScopePackageNames = ScopePackageNames;
+	Request.ScopeFolderPaths = ScopeFolderPaths;
+	Request.OnCompleted = OnCompleted;
+
+	if (!bRequestInProgress)
+	{
+		StartNextRequest();
+	}
+}
+
+void FRedirectorFixupService::StartNextRequest()
+{
+	if (PendingRequests.Num() == 0)
+	{
+		return;
+	}
+
+	RefreshRedirectorCache();
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	const FFixupRequest& Request = PendingRequests[0];
+	RedirectorPathsToLoad.Reset();
+	LoadedRedirectorPaths.Reset();
+	ReferencerPackageNames.Reset();
+	for (const FAssetData& RedirectorData : CachedRedirectors)
+	{
+		if (IsRedirectorInScope(RedirectorData, Request))
+		{
+			RedirectorPathsToLoad.Add(RedirectorData.GetSoftObjectPath());
+			AssetRegistry.GetReferencers(RedirectorData.PackageName, ReferencerPackageNames, UE::AssetRegistry::EDependencyCategory::Package);
+		}
+	}
+
+	bRequestInProgress = true;
+	if (RedirectorPathsToLoad.Num() == 0)
+	{
+		FinishCurrentRequest();
+		return;
+	}
+	LoadNextBatch();
+}
+
+void FRedirectorFixupService::LoadNextBatch()
+{
+	if (RedirectorPathsToLoad.Num() == 0)
+	{
+		TArray<UObjectRedirector*> RedirectorsToFix;
+		for (const FSoftObjectPath& RedirectorPath : LoadedRedirectorPaths)
+		{
+			if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorPath.ResolveObject()))
+			{
+				RedirectorsToFix.Add(RedirectorToFix);
+			}
+		}
+
+		if (RedirectorsToFix.Num() > 0)
+		{
+			FAssetToolsModule& AssetToolsModule =
+				FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+			AssetToolsModule.Get().FixupReferencers(RedirectorsToFix);
+		}
+
+		FinishCurrentRequest();
+		return;
+	}
+
+	const int32 BatchSize = FMath::Min(RedirectorFixup::LoadBatchSize, RedirectorPathsToLoad.Num());
+	TArray<FSoftObjectPath> BatchPaths(RedirectorPathsToLoad.GetData(), BatchSize);
+	RedirectorPathsToLoad.RemoveAt(0, BatchSize);
+	LoadedRedirectorPaths.Append(BatchPaths);
+
+	TSharedPtr<FStreamableHandle> LoadHandle = StreamableManager.RequestAsyncLoad(
+		BatchPaths,
+		FStreamableDelegate::CreateRaw(this, &FRedirectorFixupService::LoadNextBatch)
+	);
+	if (LoadHandle.IsValid())
+	{
+		// Keep the loaded redirectors alive until FixupReferencers has run
+		LoadHandles.Add(LoadHandle);
+	}
+	else
+	{
+		LoadNextBatch();
+	}
+}
+
+void FRedirectorFixupService::FinishCurrentRequest()
+{
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->ReleaseHandle();
+		}
+	}
+	LoadHandles.Reset();
+
+	if (ReferencerPackageNames.Num() > 0)
+	{
+		ReferencersFixedUpDelegate.Broadcast(ReferencerPackageNames);
+	}
+
+	FFixupRequest FinishedRequest = MoveTemp(PendingRequests[0]);
+	PendingRequests.RemoveAt(0);
+	bRequestInProgress = false;
+
+	FinishedRequest.OnCompleted.ExecuteIfBound();
+
+	if (!bRequestInProgress)
+	{
+		StartNextRequest();
+	}
+}
+
+void FRedirectorFixupService::RefreshRedirectorCache()
+{
+	if (!bRedirectorCacheDirty)
+	{
+		return;
+	}
+
+	FAssetRegistryModule& AssetRegistryModule =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace("/Game");
+	Filter.ClassPaths.Emplace(UObjectRedirector::StaticClass()->GetClassPathName());
+
+	CachedRedirectors.Reset();
+	AssetRegistryModule.Get().GetAssets(Filter, CachedRedirectors);
+	bRedirectorCacheDirty = false;
+}
+
+bool FRedirectorFixupService::IsRedirectorInScope(const FAssetData& RedirectorData, const FFixupRequest& Request) const
+{
+	if (RedirectorFixup::IsUnderAnyFolder(RedirectorData.PackageName, Request.ScopeFolderPaths))
+	{
+		return true;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	auto IsInScope = [&Request](FName PackageName)
+	{
+		return Request.ScopePackageNames.Contains(PackageName) ||
+			RedirectorFixup::IsUnderAnyFolder(PackageName, Request.ScopeFolderPaths);
+	};
+
+	// The redirector's target
+	TArray<FName> Dependencies;
+	AssetRegistry.GetDependencies(RedirectorData.PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+	for (const FName& Dependency : Dependencies)
+	{
+		if (IsInScope(Dependency))
+		{
+			return true;
+		}
+	}
+
+	// Packages still pointing at the redirector
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(RedirectorData.PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+	for (const FName& Referencer : Referencers)
+	{
+		if (IsInScope(Referencer))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FRedirectorFixupService::OnRedirectorAssetChanged(const FAssetData& AssetData)
+{
+	if (AssetData.IsRedirector())
+	{
+		bRedirectorCacheDirty = true;
+	}
+}
+
+void FRedirectorFixupService::OnRedirectorAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	OnRedirectorAssetChanged(AssetData);
+}
@@ -0,0 +1,422 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetContentHasher.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "AssetAnalysis/AssetDiskUsage.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/PackageFileSummary.h"
+#include "UObject/ObjectResource.h"
+#include "Serialization/ArchiveProxy.h"
+
+namespace AssetContentHash
+{
+	constexpr int64 ReadBufferSize = 1024 * 1024;
+
+	// Reads FNames as indices into an already loaded name map, the way the linker does
+	class FNameMapReader : public FArchiveProxy
+	{
+	public:
+		FNameMapReader(FArchive& InInnerArchive, const TArray<FName>& InNameMap)
+			: FArchiveProxy(InInnerArchive)
+			, NameMap(InNameMap)
+		{
+		}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 NameIndex = 0;
+			int32 Number = 0;
+			InnerArchive << NameIndex << Number;
+			if (!NameMap.IsValidIndex(NameIndex))
+			{
+				SetError();
+				Name = NAME_None;
+				return *this;
+			}
+			Name = FName(NameMap[NameIndex], Number);
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& NameMap;
+	};
+
+	struct FPackageHeader
+	{
+		int64 TotalHeaderSize = 0;
+		// The name map and the import paths in file order, which the export payload indexes into.
+		// The package's own names are replaced, so a copy saved under another name still matches
+		TArray<FString> ResolvedTables;
+	};
+
+	static FString ResolveImportPath(const TArray<FObjectImport>& Imports, int32 ImportIndex)
+	{
+		FString ImportPath = Imports[ImportIndex].ObjectName.ToString();
+		TSet<int32> VisitedImports;
+		for (FPackageIndex OuterIndex = Imports[ImportIndex].OuterIndex; !OuterIndex.IsNull();)
+		{
+			if (!OuterIndex.IsImport() || !Imports.IsValidIndex(OuterIndex.ToImport()) || VisitedImports.Contains(OuterIndex.ToImport()))
+			{
+				// An export outer, or a broken table; keep the raw index so it still has to match
+				ImportPath = FString::Printf(TEXT("%d"), OuterIndex.ForDebugging()) + TEXT(".") + ImportPath;
+				break;
+			}
+			VisitedImports.Add(OuterIndex.ToImport());
+			const FObjectImport& OuterImport = Imports[OuterIndex.ToImport()];
+			ImportPath = OuterImport.ObjectName.ToString() + TEXT(".") + ImportPath;
+			OuterIndex = OuterImport.OuterIndex;
+		}
+		return Imports[ImportIndex].ClassPackage.ToString() + TEXT(".") + Imports[ImportIndex].ClassName.ToString() + TEXT(" ") + ImportPath;
+	}
+
+	static bool ReadPackageHeader(const FString& PackageFilename, FName PackageName, FPackageHeader& OutHeader)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*PackageFilename));
+		if (!Reader)
+		{
+			return false;
+		}
+
+		FPackageFileSummary Summary;
+		*Reader << Summary;
+		if (Reader->IsError() || Summary.Tag != PACKAGE_FILE_TAG || Summary.TotalHeaderSize <= 0 ||
+			Summary.TotalHeaderSize > Reader->TotalSize())
+		{
+			return false;
+		}
+		Reader->SetUEVer(Summary.GetFileVersionUE());
+		Reader->SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+		Reader->SetEngineVer(Summary.SavedByEngineVersion);
+		Reader->SetCustomVersions(Summary.GetCustomVersionContainer());
+		Reader->SetFilterEditorOnly((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0);
+
+		const FString PackageNameString = PackageName.ToString();
+		const FString AssetNameString = FPackageName::GetShortName(PackageNameString);
+		const FString PackagePathString = FPackageName::GetLongPackagePath(PackageNameString);
+
+		TArray<FName> NameMap;
+		NameMap.Reserve(Summary.NameCount);
+		OutHeader.ResolvedTables.Reset();
+		OutHeader.ResolvedTables.Reserve(Summary.NameCount + Summary.ImportCount + 1);
+		Reader->Seek(Summary.NameOffset);
+		for (int32 NameIndex = 0; NameIndex < Summary.NameCount && !Reader->IsError(); ++NameIndex)
+		{
+			FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
+			*Reader << NameEntry;
+			const FName Name(NameEntry);
+			NameMap.Add(Name);
+
+			FString NameString = Name.ToString();
+			if (NameString.Equals(PackageNameString, ESearchCase::IgnoreCase))
+			{
+				NameString = TEXT("$Package");
+			}
+			else if (NameString.Equals(AssetNameString, ESearchCase::IgnoreCase))
+			{
+				NameString = TEXT("$Asset");
+			}
+			else if (NameString.Equals(PackagePathString, ESearchCase::IgnoreCase))
+			{
+				NameString = TEXT("$PackagePath");
+			}
+			OutHeader.ResolvedTables.Add(MoveTemp(NameString));
+		}
+		OutHeader.ResolvedTables.Add(FString());
+
+		TArray<FObjectImport> Imports;
+		Imports.SetNum(Summary.ImportCount);
+		FNameMapReader NameMapReader(*Reader, NameMap);
+		NameMapReader.Seek(Summary.ImportOffset);
+		for (FObjectImport& Import : Imports)
+		{
+			NameMapReader << Import;
+		}
+		if (Reader->IsError() || NameMapReader.IsError())
+		{
+			return false;
+		}
+		for (int32 ImportIndex = 0; ImportIndex < Imports.Num(); ++ImportIndex)
+		{
+			OutHeader.ResolvedTables.Add(ResolveImportPath(Imports, ImportIndex));
+		}
+
+		OutHeader.TotalHeaderSize = Summary.TotalHeaderSize;
+		return true;
+	}
+
+	static bool CompareFiles(
+		const FString& FilenameA, int64 OffsetA,
+		const FString& FilenameB, int64 OffsetB,
+		TArray<uint8>& ReadBufferA, TArray<uint8>& ReadBufferB
+	)
+	{
+		TUniquePtr<FArchive> ReaderA(IFileManager::Get().CreateFileReader(*FilenameA));
+		TUniquePtr<FArchive> ReaderB(IFileManager::Get().CreateFileReader(*FilenameB));
+		if (!ReaderA || !ReaderB)
+		{
+			return false;
+		}
+
+		int64 Remaining = ReaderA->TotalSize() - OffsetA;
+		if (Remaining != ReaderB->TotalSize() - OffsetB)
+		{
+			return false;
+		}
+
+		ReaderA->Seek(OffsetA);
+		ReaderB->Seek(OffsetB);
+		while (Remaining > 0)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, AssetContentHash::ReadBufferSize);
+			ReaderA->Serialize(ReadBufferA.GetData(), ChunkSize);
+			ReaderB->Serialize(ReadBufferB.GetData(), ChunkSize);
+			if (ReaderA->IsError() || ReaderB->IsError() || FMemory::Memcmp(ReadBufferA.GetData(), ReadBufferB.GetData(), ChunkSize) != 0)
+			{
+				return false;
+			}
+			Remaining -= ChunkSize;
+		}
+		return true;
+	}
+
+	static void HashFile(const FString& Filename, int64 Offset, TArray<uint8>& ReadBuffer, FXxHash64Builder& HashBuilder)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+		if (!Reader)
+		{
+			return;
+		}
+
+		const int64 TotalSize = Reader->TotalSize();
+		Reader->Seek(Offset);
+		for (int64 Remaining = TotalSize - Offset; Remaining > 0 && !Reader->IsError();)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, AssetContentHash::ReadBufferSize);
+			Reader->Serialize(ReadBuffer.GetData(), ChunkSize);
+			HashBuilder.Update(ReadBuffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+	}
+}
+
+TArray<TArray<TSharedPtr<FAssetData>>> FAssetContentHasher::FindDuplicateContent(
+	const TArray<TSharedPtr<FAssetData>>& AssetsData,
+	FAssetScanTask* ScanTask
+)
+{
+	TArray<TArray<TSharedPtr<FAssetData>>> DuplicateGroups;
+
+	TArray<FString> PackageFilenames;
+	TArray<int64> HeaderSizes;
+	TArray<int64> PayloadSizes;
+	TArray<uint64> ReferenceHashes;
+	PackageFilenames.SetNum(AssetsData.Num());
+	HeaderSizes.SetNumZeroed(AssetsData.Num());
+	PayloadSizes.SetNumZeroed(AssetsData.Num());
+	ReferenceHashes.SetNumZeroed(AssetsData.Num());
+	ParallelFor(AssetsData.Num(), [&AssetsData, &PackageFilenames, &HeaderSizes, &PayloadSizes, &ReferenceHashes](int32 AssetIndex)
+		{
+			const FName PackageName = AssetsData[AssetIndex]->PackageName;
+			AssetContentHash::FPackageHeader PackageHeader;
+			if (FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilenames[AssetIndex]) &&
+				AssetContentHash::ReadPackageHeader(PackageFilenames[AssetIndex], PackageName, PackageHeader))
+			{
+				HeaderSizes[AssetIndex] = PackageHeader.TotalHeaderSize;
+				PayloadSizes[AssetIndex] = FAssetDiskUsage::GetPackageFileSize(PackageFilenames[AssetIndex]) - HeaderSizes[AssetIndex];
+				ReferenceHashes[AssetIndex] = HashReferences(GetSortedDependencies(PackageName), PackageHeader.ResolvedTables);
+			}
+		}
+	);
+
+	// Only assets sharing a class, a payload size and the tables the payload indexes into can be identical, everything else is never read
+	using FSizeGroupKey = TTuple<FTopLevelAssetPath, int64, uint64>;
+	TMap<FSizeGroupKey, TArray<int32>> SizeGroups;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		if (PayloadSizes[AssetIndex] > 0)
+		{
+			SizeGroups.FindOrAdd(FSizeGroupKey(AssetsData[AssetIndex]->AssetClassPath, PayloadSizes[AssetIndex], ReferenceHashes[AssetIndex])).Add(AssetIndex);
+		}
+	}
+
+	TArray<int32> AssetIndicesToHash;
+	for (const TPair<FSizeGroupKey, TArray<int32>>& SizeGroup : SizeGroups)
+	{
+		if (SizeGroup.Value.Num() > 1)
+		{
+			AssetIndicesToHash.Append(SizeGroup.Value);
+		}
+	}
+	AssetIndicesToHash.Sort();
+
+	TArray<uint64> ContentHashes;
+	ContentHashes.SetNumZeroed(AssetIndicesToHash.Num());
+	std::atomic<int32> NumHashed = 0;
+	TArray<TArray<uint8>> ReadBuffers;
+	ParallelForWithTaskContext(
+		ReadBuffers,
+		AssetIndicesToHash.Num(),
+		[](int32 ContextIndex, int32 NumContexts)
+		{
+			TArray<uint8> ReadBuffer;
+			ReadBuffer.SetNumUninitialized(AssetContentHash::ReadBufferSize);
+			return ReadBuffer;
+		},
+		[&](TArray<uint8>& ReadBuffer, int32 HashIndex)
+		{
+			if (ScanTask && ScanTask->IsCancelled())
+			{
+				return;
+			}
+
+			const int32 AssetIndex = AssetIndicesToHash[HashIndex];
+			ContentHashes[HashIndex] = HashPayload(PackageFilenames[AssetIndex], HeaderSizes[AssetIndex], ReadBuffer);
+
+			const int32 NewNumHashed = ++NumHashed;
+			if (ScanTask && (NewNumHashed & 63) == 0)
+			{
+				ScanTask->SetProgress(NewNumHashed, AssetIndicesToHash.Num());
+			}
+		}
+	);
+	if (ScanTask && ScanTask->IsCancelled())
+	{
+		return DuplicateGroups;
+	}
+
+	using FHashGroupKey = TTuple<FTopLevelAssetPath, uint64, uint64>;
+	TMap<FHashGroupKey, int32> GroupIndices;
+	TArray<TArray<TSharedPtr<FAssetData>>> HashGroups;
+	for (int32 HashIndex = 0; HashIndex < AssetIndicesToHash.Num(); ++HashIndex)
+	{
+		const int32 AssetIndex = AssetIndicesToHash[HashIndex];
+		const TSharedPtr<FAssetData>& AssetData = AssetsData[AssetIndex];
+		int32& GroupIndex = GroupIndices.FindOrAdd(FHashGroupKey(AssetData->AssetClassPath, ReferenceHashes[AssetIndex], ContentHashes[HashIndex]), INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = HashGroups.AddDefaulted();
+		}
+		HashGroups[GroupIndex].Add(AssetData);
+	}
+
+	for (TArray<TSharedPtr<FAssetData>>& HashGroup : HashGroups)
+	{
+		if (HashGroup.Num() > 1)
+		{
+			DuplicateGroups.Add(MoveTemp(HashGroup));
+		}
+	}
+	return DuplicateGroups;
+}
+
+bool FAssetContentHasher::HaveIdenticalContent(const FAssetData& AssetDataA, const FAssetData& AssetDataB)
+{
+	if (AssetDataA.AssetClassPath != AssetDataB.AssetClassPath ||
+		GetSortedDependencies(AssetDataA.PackageName) != GetSortedDependencies(AssetDataB.PackageName))
+	{
+		return false;
+	}
+
+	FString PackageFilenameA;
+	FString PackageFilenameB;
+	if (!FPackageName::DoesPackageExist(AssetDataA.PackageName.ToString(), &PackageFilenameA) ||
+		!FPackageName::DoesPackageExist(AssetDataB.PackageName.ToString(), &PackageFilenameB))
+	{
+		return false;
+	}
+
+	// The payload only means the same thing if the names and imports it indexes into are the same, in the same order
+	AssetContentHash::FPackageHeader PackageHeaderA;
+	AssetContentHash::FPackageHeader PackageHeaderB;
+	if (!AssetContentHash::ReadPackageHeader(PackageFilenameA, AssetDataA.PackageName, PackageHeaderA) ||
+		!AssetContentHash::ReadPackageHeader(PackageFilenameB, AssetDataB.PackageName, PackageHeaderB) ||
+		PackageHeaderA.ResolvedTables.Num() != PackageHeaderB.ResolvedTables.Num())
+	{
+		return false;
+	}
+	for (int32 EntryIndex = 0; EntryIndex < PackageHeaderA.ResolvedTables.Num(); ++EntryIndex)
+	{
+		if (!PackageHeaderA.ResolvedTables[EntryIndex].Equals(PackageHeaderB.ResolvedTables[EntryIndex], ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+
+	TArray<uint8> ReadBufferA;
+	TArray<uint8> ReadBufferB;
+	ReadBufferA.SetNumUninitialized(AssetContentHash::ReadBufferSize);
+	ReadBufferB.SetNumUninitialized(AssetContentHash::ReadBufferSize);
+	if (!AssetContentHash::CompareFiles(
+		PackageFilenameA, PackageHeaderA.TotalHeaderSize,
+		PackageFilenameB, PackageHeaderB.TotalHeaderSize,
+		ReadBufferA, ReadBufferB))
+	{
+		return false;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	for (const TCHAR* SidecarExtension : FAssetDiskUsage::GetSidecarExtensions())
+	{
+		const FString SidecarFilenameA = FPaths::ChangeExtension(PackageFilenameA, SidecarExtension);
+		const FString SidecarFilenameB = FPaths::ChangeExtension(PackageFilenameB, SidecarExtension);
+		const bool bSidecarExistsA = FileManager.FileExists(*SidecarFilenameA);
+		if (bSidecarExistsA != FileManager.FileExists(*SidecarFilenameB))
+		{
+			return false;
+		}
+		if (bSidecarExistsA && !AssetContentHash::CompareFiles(SidecarFilenameA, 0, SidecarFilenameB, 0, ReadBufferA, ReadBufferB))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+TArray<FName> FAssetContentHasher::GetSortedDependencies(FName PackageName)
+{
+	TArray<FName> Dependencies;
+	IAssetRegistry::GetChecked().GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+	Dependencies.Sort(FNameLexicalLess());
+	return Dependencies;
+}
+
+uint64 FAssetContentHasher::HashReferences(const TArray<FName>& SortedDependencies, const TArray<FString>& ResolvedTables)
+{
+	FXxHash64Builder HashBuilder;
+	for (const FName& Dependency : SortedDependencies)
+	{
+		const FNameBuilder DependencyName(Dependency);
+		HashBuilder.Update(DependencyName.GetData(), DependencyName.Len() * sizeof(TCHAR));
+		HashBuilder.Update(TEXT("\n"), sizeof(TCHAR));
+	}
+	HashBuilder.Update(TEXT("\n"), sizeof(TCHAR));
+	for (const FString& Entry : ResolvedTables)
+	{
+		HashBuilder.Update(*Entry, Entry.Len() * sizeof(TCHAR));
+		HashBuilder.Update(TEXT("\n"), sizeof(TCHAR));
+	}
+	return HashBuilder.Finalize().Hash;
+}
+
+uint64 FAssetContentHasher::HashPayload(const FString& PackageFilename, int64 HeaderSize, TArray<uint8>& ReadBuffer)
+{
+	FXxHash64Builder HashBuilder;
+	AssetContentHash::HashFile(PackageFilename, HeaderSize, ReadBuffer, HashBuilder);
+
+	IFileManager& FileManager = IFileManager::Get();
+	for (const TCHAR* SidecarExtension : FAssetDiskUsage::GetSidecarExtensions())
+	{
+		const FString SidecarFilename = FPaths::ChangeExtension(PackageFilename, SidecarExtension);
+		if (FileManager.FileExists(*SidecarFilename))
+		{
+			AssetContentHash::HashFile(SidecarFilename, 0, ReadBuffer, HashBuilder);
+		}
+	}
+	return HashBuilder.Finalize().Hash;
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetDiskUsage.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace AssetDiskUsage
+{
+	const TCHAR* SidecarExtensions[] = { TEXT(".uexp"), TEXT(".ubulk"), TEXT(".uptnl") };
+}
+
+TConstArrayView<const TCHAR*> FAssetDiskUsage::GetSidecarExtensions()
+{
+	return AssetDiskUsage::SidecarExtensions;
+}
+
+int64 FAssetDiskUsage::GetPackageDiskSize(FName PackageName)
+{
+	FString PackageFilename;
+	if (!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename))
+	{
+		return 0;
+	}
+	return GetPackageFileSize(PackageFilename);
+}
+
+int64 FAssetDiskUsage::GetPackageFileSize(const FString& PackageFilename)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	int64 DiskSize = FMath::Max<int64>(FileManager.FileSize(*PackageFilename), 0);
+	for (const TCHAR* SidecarExtension : AssetDiskUsage::SidecarExtensions)
+	{
+		DiskSize += FMath::Max<int64>(FileManager.FileSize(*FPaths::ChangeExtension(PackageFilename, SidecarExtension)), 0);
+	}
+	return DiskSize;
+}
+
+int64 FAssetDiskUsage::GetTotalDiskSize(const TSet<FName>& PackageNames)
+{
+	const TArray<FName> PackageNameArray = PackageNames.Array();
+	std::atomic<int64> TotalDiskSize = 0;
+	ParallelFor(PackageNameArray.Num(), [&PackageNameArray, &TotalDiskSize](int32 PackageIndex)
+		{
+			TotalDiskSize += GetPackageDiskSize(PackageNameArray[PackageIndex]);
+		}
+	);
+	return TotalDiskSize;
+}
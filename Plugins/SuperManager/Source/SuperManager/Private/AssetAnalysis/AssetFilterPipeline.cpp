@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetFilterPipeline.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+
+FAssetClassFilterStage::FAssetClassFilterStage(const TArray<FString>& InClassNames)
+{
+	for (const FString& ClassName : InClassNames)
+	{
+		ClassNames.Add(FName(*ClassName.TrimStartAndEnd()));
+	}
+}
+
+bool FAssetClassFilterStage::Matches(const FAssetData& AssetData) const
+{
+	return ClassNames.Contains(AssetData.AssetClassPath.GetAssetName());
+}
+
+FAssetPackageSetFilterStage::FAssetPackageSetFilterStage(TSet<FName>&& InPackageNames)
+	: PackageNames(MoveTemp(InPackageNames))
+{
+}
+
+bool FAssetPackageSetFilterStage::Matches(const FAssetData& AssetData) const
+{
+	return PackageNames.Contains(AssetData.PackageName);
+}
+
+FAssetPathGlobFilterStage::FAssetPathGlobFilterStage(const FString& InPathGlob)
+	: PathGlob(InPathGlob)
+{
+}
+
+bool FAssetPathGlobFilterStage::Matches(const FAssetData& AssetData) const
+{
+	TStringBuilder<FName::StringBufferSize> PackageNameBuilder;
+	AssetData.PackageName.AppendString(PackageNameBuilder);
+	return FString(PackageNameBuilder.ToView()).MatchesWildcard(PathGlob);
+}
+
+FAssetTagValueFilterStage::FAssetTagValueFilterStage(FName InTagName, const FString& InTagValue)
+	: TagName(InTagName)
+	, TagValue(InTagValue)
+{
+}
+
+bool FAssetTagValueFilterStage::Matches(const FAssetData& AssetData) const
+{
+	FString FoundValue;
+	if (!AssetData.GetTagValue(TagName, FoundValue))
+	{
+		return false;
+	}
+	return TagValue.IsEmpty() || FoundValue.Equals(TagValue, ESearchCase::IgnoreCase);
+}
+
+FAssetSizeRangeFilterStage::FAssetSizeRangeFilterStage(int64 InMinSize, int64 InMaxSize)
+	: MinSize(InMinSize)
+	, MaxSize(InMaxSize)
+{
+}
+
+bool FAssetSizeRangeFilterStage::Matches(const FAssetData& AssetData) const
+{
+	const TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(AssetData.PackageName);
+	return PackageData.IsSet() && PackageData->DiskSize >= MinSize && PackageData->DiskSize <= MaxSize;
+}
+
+void FAssetFilterPipeline::SetAssetsData(const TArray<TSharedPtr<FAssetData>>& InAssetsData)
+{
+	AssetsData = InAssetsData;
+	for (FStageState& StageState : Stages)
+	{
+		StageState.Results.Reset();
+		StageState.Results.SetNumZeroed(AssetsData.Num());
+	}
+}
+
+void FAssetFilterPipeline::RemoveAssetsData(const TSet<FName>& PackageNames)
+{
+	int32 KeptCount = 0;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		if (PackageNames.Contains(AssetsData[AssetIndex]->PackageName))
+		{
+			continue;
+		}
+		if (KeptCount != AssetIndex)
+		{
+			AssetsData[KeptCount] = MoveTemp(AssetsData[AssetIndex]);
+			for (FStageState& StageState : Stages)
+			{
+				StageState.Results[KeptCount] = StageState.Results[AssetIndex];
+			}
+		}
+		++KeptCount;
+	}
+
+	AssetsData.SetNum(KeptCount);
+	for (FStageState& StageState : Stages)
+	{
+		StageState.Results.SetNum(KeptCount);
+	}
+}
+
+void FAssetFilterPipeline::SetStage(FName SlotName, TSharedPtr<FAssetFilterStage> Stage)
+{
+	const int32 ExistingIndex = Stages.IndexOfByPredicate([SlotName](const FStageState& StageState)
+		{
+			return StageState.SlotName == SlotName;
+		}
+	);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		Stages.RemoveAt(ExistingIndex);
+	}
+	if (!Stage.IsValid())
+	{
+		return;
+	}
+
+	FStageState NewStageState{ SlotName, Stage.ToSharedRef(), TArray<uint8>() };
+	NewStageState.Results.SetNumZeroed(AssetsData.Num());
+
+	// Stable by cost, so the evaluation order within a pass is cheapest first
+	const int32 InsertIndex = Stages.IndexOfByPredicate([Cost = Stage->GetCost()](const FStageState& StageState)
+		{
+			return StageState.Stage->GetCost() > Cost;
+		}
+	);
+	Stages.Insert(MoveTemp(NewStageState), InsertIndex == INDEX_NONE ? Stages.Num() : InsertIndex);
+}
+
+void FAssetFilterPipeline::SetCombineMode(EAssetFilterCombineMode InCombineMode)
+{
+	CombineMode = InCombineMode;
+}
+
+bool FAssetFilterPipeline::HasStages() const
+{
+	return Stages.Num() > 0;
+}
+
+TArray<TSharedPtr<FAssetData>> FAssetFilterPipeline::Evaluate()
+{
+	if (Stages.Num() == 0)
+	{
+		return AssetsData;
+	}
+
+	TArray<bool> AssetPassed;
+	AssetPassed.SetNumZeroed(AssetsData.Num());
+	const bool bMatchAll = CombineMode == EAssetFilterCombineMode::MatchAll;
+
+	ParallelFor(AssetsData.Num(), [this, &AssetPassed, bMatchAll](int32 AssetIndex)
+		{
+			// MatchAll stops at the first failing stage, MatchAny at the first passing one
+			bool bPassed = bMatchAll;
+			for (FStageState& StageState : Stages)
+			{
+				uint8& StageResult = StageState.Results[AssetIndex];
+				if (StageResult == Unknown)
+				{
+					StageResult = StageState.Stage->Matches(*AssetsData[AssetIndex]) ? Passed : Failed;
+				}
+				if ((StageResult == Passed) != bMatchAll)
+				{
+					bPassed = !bMatchAll;
+					break;
+				}
+			}
+			AssetPassed[AssetIndex] = bPassed;
+		}
+	);
+
+	TArray<TSharedPtr<FAssetData>> PassedAssetsData;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		if (AssetPassed[AssetIndex])
+		{
+			PassedAssetsData.Add(AssetsData[AssetIndex]);
+		}
+	}
+	return PassedAssetsData;
+}
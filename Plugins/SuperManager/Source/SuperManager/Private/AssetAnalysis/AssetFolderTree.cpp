@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetFolderTree.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+void FAssetFolderTree::Build(const FString& InRootFolderPath, FAssetScanTask* ScanTask)
+{
+	RootFolderPath = InRootFolderPath;
+	RootFolderPath.RemoveFromEnd(TEXT("/"));
+	Folders.Reset();
+	FolderIndices.Reset();
+	MaxDepth = 0;
+
+	FFolderNode& RootNode = Folders.AddDefaulted_GetRef();
+	RootNode.Path = RootFolderPath;
+	FolderIndices.Add(RootFolderPath, 0);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FString> SubPaths;
+	AssetRegistry.GetSubPaths(RootFolderPath, SubPaths, true);
+	for (const FString& SubPath : SubPaths)
+	{
+		FindOrAddFolder(SubPath);
+	}
+
+	TArray<FAssetData> AssetsDataUnderRoot;
+	AssetRegistry.GetAssetsByPath(FName(RootFolderPath), AssetsDataUnderRoot, true);
+	for (const FAssetData& AssetData : AssetsDataUnderRoot)
+	{
+		++Folders[FindOrAddFolder(AssetData.PackagePath.ToString())].ContentCount;
+	}
+
+	if (ScanTask && ScanTask->IsCancelled())
+	{
+		return;
+	}
+
+	// Anything on disk counts as well, so a folder the registry doesn't know about is never reported empty while it still holds files.
+	// An unmounted root has no directory to walk, so only the registry folders are kept
+	FString RootFilename;
+	if (FPackageName::TryConvertLongPackageNameToFilename(RootFolderPath, RootFilename))
+	{
+		WalkDiskFolders(FPaths::ConvertRelativePathToFull(RootFilename));
+	}
+
+	AccumulateContentCounts();
+
+	if (ScanTask)
+	{
+		ScanTask->SetProgress(Folders.Num(), Folders.Num());
+	}
+}
+
+void FAssetFolderTree::WalkDiskFolders(const FString& RootDirectory)
+{
+	IFileManager::Get().IterateDirectoryRecursively(*RootDirectory, [this, &RootDirectory](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+		{
+			FString RelativePath = FPaths::ConvertRelativePathToFull(FilenameOrDirectory);
+			if (!RelativePath.StartsWith(RootDirectory))
+			{
+				return true;
+			}
+			RelativePath.RightChopInline(RootDirectory.Len());
+			RelativePath.RemoveFromStart(TEXT("/"));
+
+			if (bIsDirectory)
+			{
+				FindOrAddFolder(RootFolderPath / RelativePath);
+			}
+			else
+			{
+				++Folders[FindOrAddFolder(RootFolderPath / FPaths::GetPath(RelativePath))].ContentCount;
+			}
+			return true;
+		}
+	);
+}
+
+TArray<FString> FAssetFolderTree::GetEmptyFoldersDeepestFirst() const
+{
+	TArray<TArray<int32>> FoldersByDepth;
+	FoldersByDepth.SetNum(MaxDepth + 1);
+	for (int32 FolderIndex = 1; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		if (Folders[FolderIndex].ContentCount == 0)
+		{
+			FoldersByDepth[Folders[FolderIndex].Depth].Add(FolderIndex);
+		}
+	}
+
+	TArray<FString> EmptyFolderPaths;
+	for (int32 Depth = MaxDepth; Depth > 0; --Depth)
+	{
+		for (const int32 FolderIndex : FoldersByDepth[Depth])
+		{
+			EmptyFolderPaths.Add(Folders[FolderIndex].Path);
+		}
+	}
+	return EmptyFolderPaths;
+}
+
+int32 FAssetFolderTree::FindOrAddFolder(const FString& FolderPath)
+{
+	FString NormalizedPath = FolderPath;
+	NormalizedPath.RemoveFromEnd(TEXT("/"));
+	if (const int32* FolderIndex = FolderIndices.Find(NormalizedPath))
+	{
+		return *FolderIndex;
+	}
+
+	// Paths outside the root hang off the root node
+	int32 ParentIndex = 0;
+	int32 SeparatorIndex = INDEX_NONE;
+	if (NormalizedPath.StartsWith(RootFolderPath + TEXT("/")) && NormalizedPath.FindLastChar(TEXT('/'), SeparatorIndex))
+	{
+		ParentIndex = FindOrAddFolder(NormalizedPath.Left(SeparatorIndex));
+	}
+
+	FFolderNode NewNode;
+	NewNode.Path = NormalizedPath;
+	NewNode.ParentIndex = ParentIndex;
+	NewNode.Depth = Folders[ParentIndex].Depth + 1;
+	MaxDepth = FMath::Max(MaxDepth, NewNode.Depth);
+
+	const int32 NewIndex = Folders.Add(MoveTemp(NewNode));
+	FolderIndices.Add(NormalizedPath, NewIndex);
+	return NewIndex;
+}
+
+void FAssetFolderTree::AccumulateContentCounts()
+{
+	TArray<TArray<int32>> FoldersByDepth;
+	FoldersByDepth.SetNum(MaxDepth + 1);
+	for (int32 FolderIndex = 1; FolderIndex < Folders.Num(); ++FolderIndex)
+	{
+		FoldersByDepth[Folders[FolderIndex].Depth].Add(FolderIndex);
+	}
+
+	// Children always sit one level deeper than their parent, so one pass from the bottom is enough
+	for (int32 Depth = MaxDepth; Depth > 0; --Depth)
+	{
+		for (const int32 FolderIndex : FoldersByDepth[Depth])
+		{
+			Folders[Folders[FolderIndex].ParentIndex].ContentCount += Folders[FolderIndex].ContentCount;
+		}
+	}
+}
@@ -0,0 +1,279 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetGraphSnapshot.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace AssetGraphSnapshotFormat
+{
+	// File layout: FHeader, FPackageEntry[NumPackages], int32 Edges[NumEdges], int32 NameOffsets[NumNames + 1], UTF-8 name bytes
+	const uint32 Magic = 0x534D4747;
+	const uint32 Version = 1;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 NumNames;
+		int32 NumPackages;
+		int32 NumEdges;
+		int32 NameBytesSize;
+	};
+
+	struct FPackageEntry
+	{
+		int64 Timestamp;
+		int32 NameIndex;
+		int32 FirstEdge;
+		int32 NumEdges;
+		int32 bIsMap;
+	};
+}
+
+FString FAssetGraphSnapshot::GetDefaultFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("AssetGraph.bin");
+}
+
+bool FAssetGraphSnapshot::Save(const FAssetReferenceIndex& ReferenceIndex, const FString& FilePath)
+{
+	using namespace AssetGraphSnapshotFormat;
+
+	if (!ReferenceIndex.IsBuilt())
+	{
+		return false;
+	}
+
+	const TMap<FName, TArray<FName>>& PackageDependencies = ReferenceIndex.GetPackageDependencies();
+
+	TMap<FName, int32> NameIndices;
+	TArray<FName> Names;
+	auto GetNameIndex = [&NameIndices, &Names](FName Name)
+		{
+			if (const int32* ExistingIndex = NameIndices.Find(Name))
+			{
+				return *ExistingIndex;
+			}
+			return NameIndices.Add(Name, Names.Add(Name));
+		};
+
+	TArray<FPackageEntry> PackageEntries;
+	TArray<FName> PackageNames;
+	TArray<int32> Edges;
+	PackageEntries.Reserve(PackageDependencies.Num());
+	PackageNames.Reserve(PackageDependencies.Num());
+	for (const TPair<FName, TArray<FName>>& PackageEdges : PackageDependencies)
+	{
+		FPackageEntry& PackageEntry = PackageEntries.AddZeroed_GetRef();
+		PackageEntry.NameIndex = GetNameIndex(PackageEdges.Key);
+		PackageEntry.FirstEdge = Edges.Num();
+		PackageEntry.NumEdges = PackageEdges.Value.Num();
+		for (const FName& Dependency : PackageEdges.Value)
+		{
+			Edges.Add(GetNameIndex(Dependency));
+		}
+		PackageNames.Add(PackageEdges.Key);
+	}
+
+	// The graph is only as current as the files it was read from, so each package carries its file's timestamp
+	ParallelFor(PackageEntries.Num(), [&PackageEntries, &PackageNames](int32 PackageIndex)
+		{
+			bool bIsMap = false;
+			PackageEntries[PackageIndex].Timestamp = GetPackageTimestamp(PackageNames[PackageIndex], bIsMap);
+			PackageEntries[PackageIndex].bIsMap = bIsMap;
+		}
+	);
+
+	TArray<int32> NameOffsets;
+	TArray<uint8> NameBytes;
+	NameOffsets.Reserve(Names.Num() + 1);
+	for (const FName& Name : Names)
+	{
+		NameOffsets.Add(NameBytes.Num());
+		const FTCHARToUTF8 Utf8Name(*Name.ToString());
+		NameBytes.Append(reinterpret_cast<const uint8*>(Utf8Name.Get()), Utf8Name.Length());
+	}
+	NameOffsets.Add(NameBytes.Num());
+
+	const FHeader Header{ Magic, Version, Names.Num(), PackageEntries.Num(), Edges.Num(), NameBytes.Num() };
+
+	TArray<uint8> FileBytes;
+	FileBytes.Reserve(sizeof(FHeader) + PackageEntries.Num() * sizeof(FPackageEntry) +
+		(Edges.Num() + NameOffsets.Num()) * sizeof(int32) + NameBytes.Num());
+	FileBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+	FileBytes.Append(reinterpret_cast<const uint8*>(PackageEntries.GetData()), PackageEntries.Num() * sizeof(FPackageEntry));
+	FileBytes.Append(reinterpret_cast<const uint8*>(Edges.GetData()), Edges.Num() * sizeof(int32));
+	FileBytes.Append(reinterpret_cast<const uint8*>(NameOffsets.GetData()), NameOffsets.Num() * sizeof(int32));
+	FileBytes.Append(NameBytes);
+
+	// Written next to the old snapshot first, so a crash never leaves a half-written file behind
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileBytes, *TempFilePath))
+	{
+		return false;
+	}
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true, true);
+}
+
+bool FAssetGraphSnapshot::Load(FAssetReferenceIndex& ReferenceIndex, const FString& FilePath, FAssetScanTask* ScanTask)
+{
+	using namespace AssetGraphSnapshotFormat;
+
+	if (!IFileManager::Get().FileExists(*FilePath))
+	{
+		return false;
+	}
+
+	// Mapped where the platform allows it; otherwise the file is small enough to read in one go
+	TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	TUniquePtr<IMappedFileRegion> MappedFileRegion(MappedFileHandle.IsValid() ? MappedFileHandle->MapRegion() : nullptr);
+	TArray<uint8> FileBytes;
+	const uint8* FileData = nullptr;
+	int64 FileSize = 0;
+	if (MappedFileRegion.IsValid())
+	{
+		FileData = MappedFileRegion->GetMappedPtr();
+		FileSize = MappedFileRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		FileData = FileBytes.GetData();
+		FileSize = FileBytes.Num();
+	}
+
+	if (!FileData || FileSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(FileData);
+	if (Header.Magic != Magic || Header.Version != Version ||
+		Header.NumNames < 0 || Header.NumPackages < 0 || Header.NumEdges < 0 || Header.NameBytesSize < 0)
+	{
+		return false;
+	}
+
+	const int64 PackagesOffset = sizeof(FHeader);
+	const int64 EdgesOffset = PackagesOffset + static_cast<int64>(Header.NumPackages) * sizeof(FPackageEntry);
+	const int64 NameOffsetsOffset = EdgesOffset + static_cast<int64>(Header.NumEdges) * sizeof(int32);
+	const int64 NameBytesOffset = NameOffsetsOffset + (static_cast<int64>(Header.NumNames) + 1) * sizeof(int32);
+	if (NameBytesOffset + Header.NameBytesSize != FileSize)
+	{
+		return false;
+	}
+
+	const FPackageEntry* PackageEntries = reinterpret_cast<const FPackageEntry*>(FileData + PackagesOffset);
+	const int32* Edges = reinterpret_cast<const int32*>(FileData + EdgesOffset);
+	const int32* NameOffsets = reinterpret_cast<const int32*>(FileData + NameOffsetsOffset);
+	const UTF8CHAR* NameBytes = reinterpret_cast<const UTF8CHAR*>(FileData + NameBytesOffset);
+
+	TArray<FName> Names;
+	Names.Reserve(Header.NumNames);
+	for (int32 NameIndex = 0; NameIndex < Header.NumNames; ++NameIndex)
+	{
+		const int32 NameStart = NameOffsets[NameIndex];
+		const int32 NameEnd = NameOffsets[NameIndex + 1];
+		if (NameStart < 0 || NameEnd < NameStart || NameEnd > Header.NameBytesSize)
+		{
+			return false;
+		}
+		Names.Add(FName(NameEnd - NameStart, NameBytes + NameStart));
+	}
+
+	TMap<FName, TArray<FName>> PackageDependencies;
+	PackageDependencies.Reserve(Header.NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < Header.NumPackages; ++PackageIndex)
+	{
+		const FPackageEntry& PackageEntry = PackageEntries[PackageIndex];
+		if (!Names.IsValidIndex(PackageEntry.NameIndex) || PackageEntry.FirstEdge < 0 || PackageEntry.NumEdges < 0 ||
+			static_cast<int64>(PackageEntry.FirstEdge) + PackageEntry.NumEdges > Header.NumEdges)
+		{
+			return false;
+		}
+
+		TArray<FName>& Dependencies = PackageDependencies.Add(Names[PackageEntry.NameIndex]);
+		Dependencies.Reserve(PackageEntry.NumEdges);
+		for (int32 EdgeIndex = PackageEntry.FirstEdge; EdgeIndex < PackageEntry.FirstEdge + PackageEntry.NumEdges; ++EdgeIndex)
+		{
+			if (!Names.IsValidIndex(Edges[EdgeIndex]))
+			{
+				return false;
+			}
+			Dependencies.Add(Names[Edges[EdgeIndex]]);
+		}
+	}
+	if (ScanTask && ScanTask->IsCancelled())
+	{
+		return false;
+	}
+
+	// Files are compared after the graph is in place; anything saved from here on arrives as a registry event
+	ReferenceIndex.BuildFromDependencies(MoveTemp(PackageDependencies));
+
+	TArray<bool> PackageStale;
+	PackageStale.SetNumZeroed(Header.NumPackages);
+	ParallelFor(Header.NumPackages, [PackageEntries, &Names, &PackageStale](int32 PackageIndex)
+		{
+			const FPackageEntry& PackageEntry = PackageEntries[PackageIndex];
+			PackageStale[PackageIndex] = GetPackageTimestamp(Names[PackageEntry.NameIndex], PackageEntry.bIsMap != 0) != PackageEntry.Timestamp;
+		}
+	);
+
+	TSet<FName> SnapshotPackageNames;
+	SnapshotPackageNames.Reserve(Header.NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < Header.NumPackages; ++PackageIndex)
+	{
+		const FName PackageName = Names[PackageEntries[PackageIndex].NameIndex];
+		SnapshotPackageNames.Add(PackageName);
+		if (PackageStale[PackageIndex])
+		{
+			ReferenceIndex.MarkPackageDirty(PackageName);
+		}
+	}
+
+	TArray<FAssetData> AllAssetsData;
+	IAssetRegistry::GetChecked().GetAllAssets(AllAssetsData, true);
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		if (!SnapshotPackageNames.Contains(AssetData.PackageName))
+		{
+			ReferenceIndex.MarkPackageDirty(AssetData.PackageName);
+		}
+	}
+	return true;
+}
+
+int64 FAssetGraphSnapshot::GetPackageTimestamp(FName PackageName, bool& bOutIsMap)
+{
+	bOutIsMap = false;
+	const int64 AssetTimestamp = GetPackageTimestamp(PackageName, false);
+	if (AssetTimestamp != 0)
+	{
+		return AssetTimestamp;
+	}
+
+	bOutIsMap = true;
+	return GetPackageTimestamp(PackageName, true);
+}
+
+int64 FAssetGraphSnapshot::GetPackageTimestamp(FName PackageName, bool bIsMap)
+{
+	FString PackageFilename;
+	const FString& Extension = bIsMap ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+	if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename, Extension))
+	{
+		return 0;
+	}
+
+	const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*PackageFilename);
+	return Timestamp == FDateTime::MinValue() ? 0 : Timestamp.GetTicks();
+}
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetMetricsCache.h"
+#include "AssetAnalysis/AssetDiskUsage.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+namespace AssetMetrics
+{
+	constexpr int32 WorkerBatchSize = 256;
+}
+
+bool FAssetMetricsCache::GetOrRequest(FName PackageName, FAssetMetrics& OutMetrics)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (const FAssetMetrics* Metrics = CachedMetrics.Find(PackageName))
+	{
+		OutMetrics = *Metrics;
+		return true;
+	}
+
+	EnqueueLocked(PackageName);
+	LaunchWorkerLocked();
+	return false;
+}
+
+void FAssetMetricsCache::Request(const TArray<FName>& PackageNames)
+{
+	FScopeLock ScopeLock(&Lock);
+	for (const FName& PackageName : PackageNames)
+	{
+		if (!CachedMetrics.Contains(PackageName))
+		{
+			EnqueueLocked(PackageName);
+		}
+	}
+	LaunchWorkerLocked();
+}
+
+void FAssetMetricsCache::Invalidate(FName PackageName)
+{
+	FScopeLock ScopeLock(&Lock);
+	CachedMetrics.Remove(PackageName);
+}
+
+void FAssetMetricsCache::EnqueueLocked(FName PackageName)
+{
+	bool bAlreadyQueued = false;
+	QueuedPackages.Add(PackageName, &bAlreadyQueued);
+	if (!bAlreadyQueued)
+	{
+		PackageQueue.Add(PackageName);
+	}
+}
+
+void FAssetMetricsCache::LaunchWorkerLocked()
+{
+	if (bWorkerRunning || PackageQueue.Num() == 0)
+	{
+		return;
+	}
+	bWorkerRunning = true;
+
+	// The worker keeps the cache alive until the queue is drained
+	Async(EAsyncExecution::ThreadPool, [SharedThis = AsShared()]()
+		{
+			SharedThis->ProcessQueue();
+		}
+	);
+}
+
+void FAssetMetricsCache::ProcessQueue()
+{
+	TArray<FName> Batch;
+	TArray<FAssetMetrics> BatchMetrics;
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (PackageQueue.Num() == 0)
+			{
+				bWorkerRunning = false;
+				break;
+			}
+
+			// Most recent requests first, they belong to the rows currently on screen
+			const int32 BatchNum = FMath::Min(AssetMetrics::WorkerBatchSize, PackageQueue.Num());
+			Batch.Reset();
+			Batch.Append(PackageQueue.GetData() + PackageQueue.Num() - BatchNum, BatchNum);
+			PackageQueue.RemoveAt(PackageQueue.Num() - BatchNum, BatchNum, EAllowShrinking::No);
+		}
+
+		BatchMetrics.Reset();
+		for (const FName& PackageName : Batch)
+		{
+			BatchMetrics.Add(ComputeMetrics(PackageName));
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		for (int32 BatchIndex = 0; BatchIndex < Batch.Num(); ++BatchIndex)
+		{
+			QueuedPackages.Remove(Batch[BatchIndex]);
+			CachedMetrics.Add(Batch[BatchIndex], BatchMetrics[BatchIndex]);
+		}
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
+		{
+			if (TSharedPtr<FAssetMetricsCache> PinnedThis = WeakThis.Pin())
+			{
+				PinnedThis->MetricsUpdatedDelegate.Broadcast();
+			}
+		}
+	);
+}
+
+FAssetMetrics FAssetMetricsCache::ComputeMetrics(FName PackageName)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	FAssetMetrics Metrics;
+
+	TArray<FName> LinkedPackages;
+	AssetRegistry.GetReferencers(PackageName, LinkedPackages, UE::AssetRegistry::EDependencyCategory::Package);
+	Metrics.ReferencerCount = LinkedPackages.Num();
+	LinkedPackages.Reset();
+	AssetRegistry.GetDependencies(PackageName, LinkedPackages, UE::AssetRegistry::EDependencyCategory::Package);
+	Metrics.DependencyCount = LinkedPackages.Num();
+
+	// Same size as the reclaim dialogs report, sidecar files included
+	FString PackageFilename;
+	if (FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename))
+	{
+		Metrics.DiskSize = FAssetDiskUsage::GetPackageFileSize(PackageFilename);
+		Metrics.ModifiedTime = IFileManager::Get().GetTimeStamp(*PackageFilename);
+	}
+
+	return Metrics;
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetNamingAudit.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "AssetActions/AssetPrefixRenamer.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "SuperManager.h"
+
+TArray<FAssetNamingViolation> FAssetNamingAudit::Run(
+	const TMap<UObject*, FString>& PrefixMap,
+	const TArray<FString>& ContentRoots,
+	FAssetScanTask* ScanTask,
+	bool bRecursivePaths
+)
+{
+	TArray<FAssetNamingViolation> Violations;
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = bRecursivePaths;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	for (const FString& ContentRoot : ContentRoots)
+	{
+		Filter.PackagePaths.Add(FName(ContentRoot));
+	}
+	if (Filter.PackagePaths.Num() == 0)
+	{
+		return Violations;
+	}
+
+	TArray<FAssetData> AssetsData;
+	IAssetRegistry::GetChecked().GetAssets(Filter, AssetsData);
+	if (ScanTask)
+	{
+		if (ScanTask->IsCancelled())
+		{
+			return Violations;
+		}
+		ScanTask->SetProgress(0, AssetsData.Num());
+	}
+
+	// A project has a few hundred classes and folders at most, so those are resolved up front on this thread
+	struct FClassRule
+	{
+		const FString* Prefix;
+		bool bIsMaterialInstance;
+	};
+	FAssetPrefixRenamer PrefixRenamer(PrefixMap);
+	TMap<FTopLevelAssetPath, FClassRule> ClassRules;
+	TMap<FName, bool> RootFolderPathCache;
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		if (!ClassRules.Contains(AssetData.AssetClassPath))
+		{
+			const FString* Prefix = PrefixRenamer.FindPrefix(AssetData.AssetClassPath);
+			ClassRules.Add(AssetData.AssetClassPath, { Prefix, Prefix && PrefixRenamer.IsMaterialInstanceClass(AssetData.AssetClassPath) });
+		}
+		FSuperManagerModule::IsRootFolderPackagePath(AssetData.PackagePath, RootFolderPathCache);
+	}
+
+	TArray<FString> SuggestedNames;
+	SuggestedNames.SetNum(AssetsData.Num());
+	ParallelFor(AssetsData.Num(), [&AssetsData, &ClassRules, &RootFolderPathCache, &PrefixRenamer, &SuggestedNames](int32 AssetIndex)
+		{
+			const FAssetData& AssetData = AssetsData[AssetIndex];
+			const FClassRule& ClassRule = ClassRules.FindChecked(AssetData.AssetClassPath);
+			if (!ClassRule.Prefix || AssetData.IsRedirector() || RootFolderPathCache.FindChecked(AssetData.PackagePath))
+			{
+				return;
+			}
+
+			const FString AssetName = AssetData.AssetName.ToString();
+			if (!AssetName.StartsWith(*ClassRule.Prefix))
+			{
+				SuggestedNames[AssetIndex] = PrefixRenamer.MakePrefixedName(AssetName, *ClassRule.Prefix, ClassRule.bIsMaterialInstance);
+			}
+		}
+	);
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		if (!SuggestedNames[AssetIndex].IsEmpty())
+		{
+			const FString& ExpectedPrefix = *ClassRules.FindChecked(AssetsData[AssetIndex].AssetClassPath).Prefix;
+			Violations.Add({ MoveTemp(AssetsData[AssetIndex]), ExpectedPrefix, MoveTemp(SuggestedNames[AssetIndex]) });
+		}
+	}
+	if (ScanTask)
+	{
+		ScanTask->SetProgress(AssetsData.Num(), AssetsData.Num());
+	}
+	return Violations;
+}
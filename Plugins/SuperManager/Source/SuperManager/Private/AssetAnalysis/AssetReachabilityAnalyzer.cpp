@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetReachabilityAnalyzer.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "Async/ParallelFor.h"
+
+TSet<FName> FAssetReachabilityAnalyzer::FindUnreachablePackages(
+	const FAssetReferenceIndex& ReferenceIndex,
+	const TSet<FName>& RootPackages
+)
+{
+	const TMap<FName, TArray<FName>>& PackageDependencies = ReferenceIndex.GetPackageDependencies();
+	const int32 NumPackages = PackageDependencies.Num();
+
+	// Flatten the graph into index arrays so the mark phase never touches a map
+	TArray<FName> PackageNames;
+	TMap<FName, int32> PackageIndices;
+	PackageNames.Reserve(NumPackages);
+	PackageIndices.Reserve(NumPackages);
+	for (const TPair<FName, TArray<FName>>& PackageDependency : PackageDependencies)
+	{
+		PackageIndices.Add(PackageDependency.Key, PackageNames.Add(PackageDependency.Key));
+	}
+
+	TArray<int32> EdgeOffsets;
+	TArray<int32> Edges;
+	EdgeOffsets.Reserve(NumPackages + 1);
+	for (const TPair<FName, TArray<FName>>& PackageDependency : PackageDependencies)
+	{
+		EdgeOffsets.Add(Edges.Num());
+		for (const FName& Dependency : PackageDependency.Value)
+		{
+			if (const int32* DependencyIndex = PackageIndices.Find(Dependency))
+			{
+				Edges.Add(*DependencyIndex);
+			}
+		}
+	}
+	EdgeOffsets.Add(Edges.Num());
+
+	// Mark, one frontier at a time, each frontier split across worker threads
+	TArray<int8> Marks;
+	Marks.SetNumZeroed(NumPackages);
+
+	TArray<int32> Frontier;
+	for (const FName& RootPackage : RootPackages)
+	{
+		const int32* RootIndex = PackageIndices.Find(RootPackage);
+		if (RootIndex && Marks[*RootIndex] == 0)
+		{
+			Marks[*RootIndex] = 1;
+			Frontier.Add(*RootIndex);
+		}
+	}
+
+	constexpr int32 MinNodesPerChunk = 256;
+	const int32 MaxChunks = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	TArray<TArray<int32>> NextFrontiers;
+	while (Frontier.Num() > 0)
+	{
+		const int32 NumChunks = FMath::Clamp(FMath::DivideAndRoundUp(Frontier.Num(), MinNodesPerChunk), 1, MaxChunks);
+		const int32 ChunkSize = FMath::DivideAndRoundUp(Frontier.Num(), NumChunks);
+		NextFrontiers.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			TArray<int32>& NextFrontier = NextFrontiers[ChunkIndex];
+			NextFrontier.Reset();
+
+			const int32 ChunkEnd = FMath::Min((ChunkIndex + 1) * ChunkSize, Frontier.Num());
+			for (int32 FrontierIndex = ChunkIndex * ChunkSize; FrontierIndex < ChunkEnd; ++FrontierIndex)
+			{
+				const int32 PackageIndex = Frontier[FrontierIndex];
+				for (int32 EdgeIndex = EdgeOffsets[PackageIndex]; EdgeIndex < EdgeOffsets[PackageIndex + 1]; ++EdgeIndex)
+				{
+					const int32 DependencyIndex = Edges[EdgeIndex];
+					if (FPlatformAtomics::InterlockedCompareExchange(&Marks[DependencyIndex], 1, 0) == 0)
+					{
+						NextFrontier.Add(DependencyIndex);
+					}
+				}
+			}
+		});
+
+		Frontier.Reset();
+		for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			Frontier.Append(NextFrontiers[ChunkIndex]);
+		}
+	}
+
+	// Sweep
+	TSet<FName> UnreachablePackages;
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		if (Marks[PackageIndex] == 0)
+		{
+			UnreachablePackages.Add(PackageNames[PackageIndex]);
+		}
+	}
+	return UnreachablePackages;
+}
+
+TSet<FName> FAssetReachabilityAnalyzer::FindOrphanedDependencies(
+	const FAssetReferenceIndex& ReferenceIndex,
+	const TSet<FName>& PackagesToRemove,
+	const TSet<FName>& RootPackages,
+	TSet<FName>* OutSharedDependencies
+)
+{
+	const TMap<FName, TArray<FName>>& PackageDependencies = ReferenceIndex.GetPackageDependencies();
+
+	// Everything the removed packages lead to. Roots are kept anyway, and script packages and anything else
+	// without a package of its own on disk never become deletable
+	TSet<FName> DependencyClosure;
+	TArray<FName> PackagesToVisit = PackagesToRemove.Array();
+	while (PackagesToVisit.Num() > 0)
+	{
+		const TArray<FName>* Dependencies = PackageDependencies.Find(PackagesToVisit.Pop(EAllowShrinking::No));
+		if (!Dependencies)
+		{
+			continue;
+		}
+
+		for (const FName& Dependency : *Dependencies)
+		{
+			if (PackagesToRemove.Contains(Dependency) || RootPackages.Contains(Dependency) ||
+				!PackageDependencies.Contains(Dependency) || DependencyClosure.Contains(Dependency))
+			{
+				continue;
+			}
+			DependencyClosure.Add(Dependency);
+			PackagesToVisit.Add(Dependency);
+		}
+	}
+
+	// A closure package is kept when something outside the closure and the removed set still references it.
+	// Comparing its referencer count with the references from inside finds those without walking the rest of the graph
+	TMap<FName, int32> InsideReferenceCounts;
+	InsideReferenceCounts.Reserve(DependencyClosure.Num());
+	auto CountInsideReferences = [&PackageDependencies, &DependencyClosure, &InsideReferenceCounts](const FName& PackageName)
+	{
+		if (const TArray<FName>* Dependencies = PackageDependencies.Find(PackageName))
+		{
+			for (const FName& Dependency : *Dependencies)
+			{
+				if (DependencyClosure.Contains(Dependency))
+				{
+					++InsideReferenceCounts.FindOrAdd(Dependency);
+				}
+			}
+		}
+	};
+	for (const FName& PackageToRemove : PackagesToRemove)
+	{
+		CountInsideReferences(PackageToRemove);
+	}
+	for (const FName& ClosurePackage : DependencyClosure)
+	{
+		CountInsideReferences(ClosurePackage);
+	}
+
+	// Whatever a kept package depends on inside the closure is kept too, cycles included
+	TSet<FName> KeptDependencies;
+	for (const FName& ClosurePackage : DependencyClosure)
+	{
+		if (ReferenceIndex.GetReferencerCount(ClosurePackage) > InsideReferenceCounts.FindRef(ClosurePackage))
+		{
+			KeptDependencies.Add(ClosurePackage);
+			PackagesToVisit.Add(ClosurePackage);
+		}
+	}
+	while (PackagesToVisit.Num() > 0)
+	{
+		const TArray<FName>* Dependencies = PackageDependencies.Find(PackagesToVisit.Pop(EAllowShrinking::No));
+		if (!Dependencies)
+		{
+			continue;
+		}
+
+		for (const FName& Dependency : *Dependencies)
+		{
+			if (DependencyClosure.Contains(Dependency) && !KeptDependencies.Contains(Dependency))
+			{
+				KeptDependencies.Add(Dependency);
+				PackagesToVisit.Add(Dependency);
+			}
+		}
+	}
+
+	TSet<FName> OrphanedDependencies;
+	OrphanedDependencies.Reserve(DependencyClosure.Num() - KeptDependencies.Num());
+	for (const FName& ClosurePackage : DependencyClosure)
+	{
+		if (!KeptDependencies.Contains(ClosurePackage))
+		{
+			OrphanedDependencies.Add(ClosurePackage);
+		}
+	}
+
+	if (OutSharedDependencies)
+	{
+		*OutSharedDependencies = MoveTemp(KeptDependencies);
+	}
+	return OrphanedDependencies;
+}
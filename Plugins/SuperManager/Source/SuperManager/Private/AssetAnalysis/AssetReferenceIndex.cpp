@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+void FAssetReferenceIndex::Build(FAssetScanTask* ScanTask)
+{
+	PackageDependencies.Reset();
+	ReferencerCounts.Reset();
+	bBuilt = false;
+	{
+		// Anything changing from here on is picked up by the next refresh
+		FScopeLock ScopeLock(&DirtyPackagesLock);
+		DirtyPackages.Reset();
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetData> AllAssetsData;
+	AssetRegistry.GetAllAssets(AllAssetsData, true);
+
+	TSet<FName> PackageNames;
+	PackageNames.Reserve(AllAssetsData.Num());
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		PackageNames.Add(AssetData.PackageName);
+	}
+	PackageDependencies.Reserve(PackageNames.Num());
+	ReferencerCounts.Reserve(PackageNames.Num());
+
+	// Walk the forward edges once and count them from the other side
+	int32 ProcessedCount = 0;
+	for (const FName& PackageName : PackageNames)
+	{
+		if (ScanTask && (++ProcessedCount & 1023) == 0)
+		{
+			if (ScanTask->IsCancelled())
+			{
+				Reset();
+				return;
+			}
+			ScanTask->SetProgress(ProcessedCount, PackageNames.Num());
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		AddPackageEdges(PackageName, MoveTemp(Dependencies));
+	}
+
+	bBuilt = true;
+	++Version;
+}
+
+void FAssetReferenceIndex::BuildFromDependencies(TMap<FName, TArray<FName>>&& InPackageDependencies)
+{
+	Reset();
+
+	PackageDependencies.Reserve(InPackageDependencies.Num());
+	ReferencerCounts.Reserve(InPackageDependencies.Num());
+	for (TPair<FName, TArray<FName>>& PackageEdges : InPackageDependencies)
+	{
+		AddPackageEdges(PackageEdges.Key, MoveTemp(PackageEdges.Value));
+	}
+	InPackageDependencies.Empty();
+
+	bBuilt = true;
+	++Version;
+}
+
+void FAssetReferenceIndex::Refresh(FAssetScanTask* ScanTask)
+{
+	if (!bBuilt)
+	{
+		Build(ScanTask);
+		return;
+	}
+
+	TSet<FName> PackagesToRefresh;
+	{
+		FScopeLock ScopeLock(&DirtyPackagesLock);
+		PackagesToRefresh = MoveTemp(DirtyPackages);
+		DirtyPackages.Reset();
+	}
+	if (PackagesToRefresh.Num() == 0)
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetData> PackageAssetsData;
+	for (const FName& DirtyPackage : PackagesToRefresh)
+	{
+		RemovePackageEdges(DirtyPackage);
+
+		PackageAssetsData.Reset();
+		AssetRegistry.GetAssetsByPackageName(DirtyPackage, PackageAssetsData, true);
+		if (PackageAssetsData.Num() == 0)
+		{
+			continue;
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(DirtyPackage, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		AddPackageEdges(DirtyPackage, MoveTemp(Dependencies));
+	}
+
+	++Version;
+}
+
+void FAssetReferenceIndex::MarkPackageDirty(FName PackageName)
+{
+	FScopeLock ScopeLock(&DirtyPackagesLock);
+	DirtyPackages.Add(PackageName);
+}
+
+void FAssetReferenceIndex::Reset()
+{
+	PackageDependencies.Empty();
+	ReferencerCounts.Empty();
+	{
+		FScopeLock ScopeLock(&DirtyPackagesLock);
+		DirtyPackages.Empty();
+	}
+	bBuilt = false;
+	++Version;
+}
+
+bool FAssetReferenceIndex::HasNoReferencers(FName PackageName) const
+{
+	return GetReferencerCount(PackageName) == 0;
+}
+
+int32 FAssetReferenceIndex::GetReferencerCount(FName PackageName) const
+{
+	const int32* Count = ReferencerCounts.Find(PackageName);
+	return Count ? *Count : 0;
+}
+
+void FAssetReferenceIndex::AddPackageEdges(FName PackageName, TArray<FName>&& Dependencies)
+{
+	Dependencies.Remove(PackageName);
+	for (const FName& Dependency : Dependencies)
+	{
+		++ReferencerCounts.FindOrAdd(Dependency);
+	}
+	PackageDependencies.Add(PackageName, MoveTemp(Dependencies));
+}
+
+void FAssetReferenceIndex::RemovePackageEdges(FName PackageName)
+{
+	TArray<FName> OldDependencies;
+	if (!PackageDependencies.RemoveAndCopyValue(PackageName, OldDependencies))
+	{
+		return;
+	}
+
+	for (const FName& Dependency : OldDependencies)
+	{
+		int32* Count = ReferencerCounts.Find(Dependency);
+		if (Count && --(*Count) <= 0)
+		{
+			ReferencerCounts.Remove(Dependency);
+		}
+	}
+}
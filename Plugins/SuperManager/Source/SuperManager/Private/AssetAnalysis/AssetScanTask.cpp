@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetScanTask.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+
+TSharedRef<FAssetScanTask> FAssetScanTask::Launch(
+	const FText& Title,
+	TFunction<void(FAssetScanTask&)> BackgroundWork,
+	TFunction<void()> OnCompleted
+)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FAssetScanTask> ScanTask = MakeShareable(new FAssetScanTask());
+	ScanTask->Title = Title;
+	ScanTask->OnCompleted = MoveTemp(OnCompleted);
+
+	FAsyncTaskNotificationConfig NotificationConfig;
+	NotificationConfig.TitleText = Title;
+	NotificationConfig.ProgressText = FText::FromString(TEXT("Scanning..."));
+	NotificationConfig.bCanCancel = true;
+	NotificationConfig.bKeepOpenOnFailure = false;
+	ScanTask->Notification = MakeUnique<FAsyncTaskNotification>(NotificationConfig);
+
+	// The ticker owns the task until it reports back
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([ScanTask](float DeltaTime)
+		{
+			return ScanTask->Tick(DeltaTime);
+		}
+	));
+
+	ScanTask->WorkFuture = Async(EAsyncExecution::ThreadPool, [ScanTask, BackgroundWork = MoveTemp(BackgroundWork)]()
+		{
+			BackgroundWork(ScanTask.Get());
+			ScanTask->bWorkFinished = true;
+		}
+	);
+
+	return ScanTask;
+}
+
+void FAssetScanTask::SetProgress(int32 InCompletedCount, int32 InTotalCount)
+{
+	CompletedCount = InCompletedCount;
+	TotalCount = InTotalCount;
+}
+
+void FAssetScanTask::CancelAndWait()
+{
+	bCancelled = true;
+	if (WorkFuture.IsValid())
+	{
+		WorkFuture.Wait();
+	}
+}
+
+bool FAssetScanTask::Tick(float DeltaTime)
+{
+	if (!bCancelled && Notification->GetPromptAction() == EAsyncTaskNotificationPromptAction::Cancel)
+	{
+		bCancelled = true;
+		Notification->SetProgressText(FText::FromString(TEXT("Cancelling...")));
+	}
+
+	if (!bWorkFinished)
+	{
+		if (!bCancelled && TotalCount > 0)
+		{
+			Notification->SetProgressText(FText::FromString(
+				FString::Printf(TEXT("%d / %d"), CompletedCount.load(), TotalCount.load())
+			));
+		}
+		return true;
+	}
+
+	bFinished = true;
+	if (bCancelled)
+	{
+		Notification->SetComplete(Title, FText::FromString(TEXT("Cancelled")), false);
+		return false;
+	}
+
+	Notification->SetComplete(Title, FText::FromString(TEXT("Done")), true);
+	if (OnCompleted)
+	{
+		OnCompleted();
+	}
+	return false;
+}
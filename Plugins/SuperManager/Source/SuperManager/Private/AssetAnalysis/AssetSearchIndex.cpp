@@ -0,0 +1,236 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetSearchIndex.h"
+
+namespace AssetSearch
+{
+	const TCHAR PrefixMarker = TEXT('^');
+
+	FORCEINLINE uint64 MakeTrigram(const TCHAR* Chars)
+	{
+		return (uint64(uint16(Chars[0])) << 32) | (uint64(uint16(Chars[1])) << 16) | uint64(uint16(Chars[2]));
+	}
+}
+
+void FAssetSearchIndex::Build(const TArray<TSharedPtr<FAssetData>>& InAssetsData)
+{
+	Reset();
+	AssetsData = InAssetsData;
+	LowerAssetNames.Reserve(AssetsData.Num());
+
+	TMap<FName, int32> PackagePathIndices;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = *AssetsData[AssetIndex];
+
+		FString& LowerAssetName = LowerAssetNames.Add_GetRef(AssetData.AssetName.ToString().ToLower());
+		AddTrigrams(LowerAssetName, AssetIndex, AssetNameTrigrams);
+
+		int32* PackagePathIndex = PackagePathIndices.Find(AssetData.PackagePath);
+		if (!PackagePathIndex)
+		{
+			const int32 NewPathIndex = LowerPackagePaths.Add(AssetData.PackagePath.ToString().ToLower());
+			PackagePathAssetIndices.AddDefaulted();
+			AddTrigrams(LowerPackagePaths[NewPathIndex], NewPathIndex, PackagePathTrigrams);
+			PackagePathIndex = &PackagePathIndices.Add(AssetData.PackagePath, NewPathIndex);
+		}
+		PackagePathAssetIndices[*PackagePathIndex].Add(AssetIndex);
+	}
+}
+
+void FAssetSearchIndex::Reset()
+{
+	AssetsData.Reset();
+	LowerAssetNames.Reset();
+	LowerPackagePaths.Reset();
+	PackagePathAssetIndices.Reset();
+	AssetNameTrigrams.Reset();
+	PackagePathTrigrams.Reset();
+}
+
+void FAssetSearchIndex::RemoveAssetsData(const TSet<FName>& PackageNames)
+{
+	TArray<int32> NewAssetIndices;
+	NewAssetIndices.SetNumUninitialized(AssetsData.Num());
+	int32 KeptCount = 0;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		if (PackageNames.Contains(AssetsData[AssetIndex]->PackageName))
+		{
+			NewAssetIndices[AssetIndex] = INDEX_NONE;
+			continue;
+		}
+		NewAssetIndices[AssetIndex] = KeptCount;
+		if (KeptCount != AssetIndex)
+		{
+			AssetsData[KeptCount] = MoveTemp(AssetsData[AssetIndex]);
+			LowerAssetNames[KeptCount] = MoveTemp(LowerAssetNames[AssetIndex]);
+		}
+		++KeptCount;
+	}
+
+	if (KeptCount == AssetsData.Num())
+	{
+		return;
+	}
+	AssetsData.SetNum(KeptCount);
+	LowerAssetNames.SetNum(KeptCount);
+
+	// The renumbering keeps the order, so every list stays sorted; a folder with no assets left simply never adds a match
+	for (TArray<int32>& AssetIndices : PackagePathAssetIndices)
+	{
+		RemapEntries(AssetIndices, NewAssetIndices);
+	}
+	for (FTrigramPostings::TIterator It(AssetNameTrigrams); It; ++It)
+	{
+		RemapEntries(It.Value(), NewAssetIndices);
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TArray<TSharedPtr<FAssetData>> FAssetSearchIndex::Search(const FString& Query) const
+{
+	FString LowerQuery = Query.TrimStartAndEnd().ToLower();
+	const bool bPrefixMatch = LowerQuery.Len() > 0 && LowerQuery[0] == AssetSearch::PrefixMarker;
+	if (bPrefixMatch)
+	{
+		LowerQuery.RightChopInline(1);
+	}
+	if (LowerQuery.IsEmpty())
+	{
+		return AssetsData;
+	}
+
+	TBitArray<> MatchedAssets(false, AssetsData.Num());
+	TArray<int32> Candidates;
+
+	FindCandidates(LowerQuery, AssetNameTrigrams, LowerAssetNames.Num(), Candidates);
+	for (const int32 AssetIndex : Candidates)
+	{
+		if (MatchesQuery(LowerAssetNames[AssetIndex], LowerQuery, bPrefixMatch))
+		{
+			MatchedAssets[AssetIndex] = true;
+		}
+	}
+
+	FindCandidates(LowerQuery, PackagePathTrigrams, LowerPackagePaths.Num(), Candidates);
+	for (const int32 PathIndex : Candidates)
+	{
+		if (MatchesQuery(LowerPackagePaths[PathIndex], LowerQuery, bPrefixMatch))
+		{
+			for (const int32 AssetIndex : PackagePathAssetIndices[PathIndex])
+			{
+				MatchedAssets[AssetIndex] = true;
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FAssetData>> MatchedAssetsData;
+	for (TConstSetBitIterator<> It(MatchedAssets); It; ++It)
+	{
+		MatchedAssetsData.Add(AssetsData[It.GetIndex()]);
+	}
+	return MatchedAssetsData;
+}
+
+void FAssetSearchIndex::RemapEntries(TArray<int32>& EntryIndices, const TArray<int32>& NewEntryIndices)
+{
+	int32 KeptCount = 0;
+	for (const int32 EntryIndex : EntryIndices)
+	{
+		const int32 NewEntryIndex = NewEntryIndices[EntryIndex];
+		if (NewEntryIndex != INDEX_NONE)
+		{
+			EntryIndices[KeptCount++] = NewEntryIndex;
+		}
+	}
+	EntryIndices.SetNum(KeptCount, EAllowShrinking::No);
+}
+
+void FAssetSearchIndex::AddTrigrams(const FString& LowerText, int32 EntryIndex, FTrigramPostings& Postings)
+{
+	const TCHAR* Chars = *LowerText;
+	for (int32 CharIndex = 0; CharIndex + 3 <= LowerText.Len(); ++CharIndex)
+	{
+		// Entries are added in order, so checking the last posting is enough to keep each list unique and sorted
+		TArray<int32>& EntryIndices = Postings.FindOrAdd(AssetSearch::MakeTrigram(Chars + CharIndex));
+		if (EntryIndices.Num() == 0 || EntryIndices.Last() != EntryIndex)
+		{
+			EntryIndices.Add(EntryIndex);
+		}
+	}
+}
+
+void FAssetSearchIndex::FindCandidates(const FString& LowerQuery, const FTrigramPostings& Postings, int32 NumEntries, TArray<int32>& OutCandidates)
+{
+	OutCandidates.Reset();
+
+	// Too short for a trigram, every entry has to be checked
+	if (LowerQuery.Len() < 3)
+	{
+		OutCandidates.SetNumUninitialized(NumEntries);
+		for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+		{
+			OutCandidates[EntryIndex] = EntryIndex;
+		}
+		return;
+	}
+
+	TArray<const TArray<int32>*, TInlineAllocator<16>> PostingLists;
+	const TCHAR* Chars = *LowerQuery;
+	for (int32 CharIndex = 0; CharIndex + 3 <= LowerQuery.Len(); ++CharIndex)
+	{
+		const TArray<int32>* EntryIndices = Postings.Find(AssetSearch::MakeTrigram(Chars + CharIndex));
+		if (!EntryIndices)
+		{
+			return;
+		}
+		PostingLists.AddUnique(EntryIndices);
+	}
+
+	// Intersect starting from the rarest trigram
+	PostingLists.Sort([](const TArray<int32>& A, const TArray<int32>& B)
+		{
+			return A.Num() < B.Num();
+		}
+	);
+
+	OutCandidates = *PostingLists[0];
+	TArray<int32> Intersection;
+	for (int32 ListIndex = 1; ListIndex < PostingLists.Num() && OutCandidates.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& EntryIndices = *PostingLists[ListIndex];
+		Intersection.Reset();
+		int32 CandidateIndex = 0;
+		int32 EntryIndex = 0;
+		while (CandidateIndex < OutCandidates.Num() && EntryIndex < EntryIndices.Num())
+		{
+			if (OutCandidates[CandidateIndex] < EntryIndices[EntryIndex])
+			{
+				++CandidateIndex;
+			}
+			else if (EntryIndices[EntryIndex] < OutCandidates[CandidateIndex])
+			{
+				++EntryIndex;
+			}
+			else
+			{
+				Intersection.Add(OutCandidates[CandidateIndex]);
+				++CandidateIndex;
+				++EntryIndex;
+			}
+		}
+		Swap(OutCandidates, Intersection);
+	}
+}
+
+bool FAssetSearchIndex::MatchesQuery(const FString& LowerText, const FString& LowerQuery, bool bPrefixMatch)
+{
+	return bPrefixMatch ?
+		LowerText.StartsWith(LowerQuery, ESearchCase::CaseSensitive) :
+		LowerText.Contains(LowerQuery, ESearchCase::CaseSensitive);
+}
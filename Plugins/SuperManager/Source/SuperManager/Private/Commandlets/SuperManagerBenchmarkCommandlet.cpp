@@ -0,0 +1,253 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/SuperManagerBenchmarkCommandlet.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/AssetFolderTree.h"
+#include "AssetAnalysis/AssetReachabilityAnalyzer.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "DebugHeader.h"
+
+namespace SuperManagerBenchmark
+{
+	const TCHAR* CsvHeader = TEXT("Path,Packages,Density,Seconds,PeakUsedPhysicalDeltaMB,UsedPhysicalDeltaMB,Results");
+	constexpr int32 NumSyntheticFolders = 1000;
+	constexpr double BytesPerMB = 1024.0 * 1024.0;
+}
+
+USuperManagerBenchmarkCommandlet::USuperManagerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USuperManagerBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<int32> Sizes = { 10000, 100000, 1000000 };
+	FString SizesParam;
+	if (FParse::Value(*Params, TEXT("Sizes="), SizesParam))
+	{
+		TArray<FString> SizeStrings;
+		SizesParam.ParseIntoArray(SizeStrings, TEXT("+"));
+		Sizes.Reset();
+		for (const FString& SizeString : SizeStrings)
+		{
+			Sizes.Add(FMath::Max(1, FCString::Atoi(*SizeString)));
+		}
+	}
+
+	float Density = 4.f;
+	float RootFraction = 0.01f;
+	float SameNameFraction = 0.1f;
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Density="), Density);
+	FParse::Value(*Params, TEXT("RootFraction="), RootFraction);
+	FParse::Value(*Params, TEXT("SameNameFraction="), SameNameFraction);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	FString OutputFilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("Benchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	CsvRows.Reset();
+	for (const int32 NumPackages : Sizes)
+	{
+		RunSyntheticBenchmarks(GenerateSyntheticProject(NumPackages, Density, RootFraction, SameNameFraction, Seed), Density);
+	}
+	RunProjectBenchmarks(FParse::Param(*Params, TEXT("IncludeFixup")));
+
+	// Appended so consecutive runs can be compared in one file
+	FString CsvText;
+	if (!IFileManager::Get().FileExists(*OutputFilePath))
+	{
+		CsvText += SuperManagerBenchmark::CsvHeader;
+		CsvText += LINE_TERMINATOR;
+	}
+	for (const FString& CsvRow : CsvRows)
+	{
+		CsvText += CsvRow;
+		CsvText += LINE_TERMINATOR;
+	}
+
+	if (!FFileHelper::SaveStringToFile(CsvText, *OutputFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		DebugHeader::PrintLog(TEXT("SuperManagerBenchmark: failed to write ") + OutputFilePath);
+		return 1;
+	}
+	DebugHeader::PrintLog(TEXT("SuperManagerBenchmark: results appended to ") + OutputFilePath);
+	return 0;
+}
+
+USuperManagerBenchmarkCommandlet::FSyntheticProject USuperManagerBenchmarkCommandlet::GenerateSyntheticProject(
+	int32 NumPackages,
+	float Density,
+	float RootFraction,
+	float SameNameFraction,
+	int32 Seed
+)
+{
+	FSyntheticProject Project;
+	FRandomStream RandomStream(Seed);
+
+	const FTopLevelAssetPath AssetClassPath(TEXT("/Script/Engine"), TEXT("StaticMesh"));
+	const int32 NumDistinctNames = FMath::Max(1, FMath::RoundToInt(NumPackages * (1.f - FMath::Clamp(SameNameFraction, 0.f, 1.f))));
+
+	Project.PackageNames.Reserve(NumPackages);
+	Project.AssetsData.Reserve(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		const FString PackagePath = FString::Printf(TEXT("/Game/Synthetic/Folder%04d"), PackageIndex % SuperManagerBenchmark::NumSyntheticFolders);
+		const FString AssetName = FString::Printf(TEXT("SM_Asset%07d"), PackageIndex % NumDistinctNames);
+		const FName PackageName(*FString::Printf(TEXT("%s/%s_%d"), *PackagePath, *AssetName, PackageIndex));
+
+		Project.PackageNames.Add(PackageName);
+		Project.AssetsData.Add(MakeShared<FAssetData>(PackageName, FName(PackagePath), FName(AssetName), AssetClassPath));
+	}
+
+	// Uniform out-degree around Density; edges may form cycles and islands just like real content
+	const int32 MaxOutDegree = FMath::Max(0, FMath::RoundToInt(Density * 2.f));
+	Project.PackageDependencies.Reserve(NumPackages);
+	for (const FName& PackageName : Project.PackageNames)
+	{
+		TArray<FName>& Dependencies = Project.PackageDependencies.Add(PackageName);
+		const int32 OutDegree = RandomStream.RandRange(0, MaxOutDegree);
+		Dependencies.Reserve(OutDegree);
+		for (int32 EdgeIndex = 0; EdgeIndex < OutDegree; ++EdgeIndex)
+		{
+			Dependencies.Add(Project.PackageNames[RandomStream.RandRange(0, NumPackages - 1)]);
+		}
+	}
+
+	const int32 NumRoots = FMath::Clamp(FMath::RoundToInt(NumPackages * RootFraction), 1, NumPackages);
+	for (int32 RootIndex = 0; RootIndex < NumRoots; ++RootIndex)
+	{
+		Project.RootPackages.Add(Project.PackageNames[RandomStream.RandRange(0, NumPackages - 1)]);
+	}
+
+	return Project;
+}
+
+void USuperManagerBenchmarkCommandlet::RunSyntheticBenchmarks(const FSyntheticProject& Project, float Density)
+{
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const int32 NumPackages = Project.PackageNames.Num();
+
+	// Copied outside the timed body so only the build itself is measured
+	FAssetReferenceIndex SyntheticIndex;
+	TMap<FName, TArray<FName>> PackageDependencies = Project.PackageDependencies;
+	Measure(TEXT("ReferenceIndexBuild"), NumPackages, Density, [&PackageDependencies, &SyntheticIndex]()
+		{
+			SyntheticIndex.BuildFromDependencies(MoveTemp(PackageDependencies));
+			return SyntheticIndex.GetPackageDependencies().Num();
+		}
+	);
+
+	Measure(TEXT("ListUnusedAssets"), NumPackages, Density, [&Project, &SyntheticIndex]()
+		{
+			return FAssetReachabilityAnalyzer::FindUnreachablePackages(SyntheticIndex, Project.RootPackages).Num();
+		}
+	);
+
+	Measure(TEXT("ListSameNameAssets"), NumPackages, Density, [&Project, &SuperManager]()
+		{
+			TArray<TSharedPtr<FAssetData>> SameNameAssetsData;
+			SuperManager.ListSameNameAssetsForAssetList(Project.AssetsData, SameNameAssetsData);
+			return SameNameAssetsData.Num();
+		}
+	);
+
+	Measure(TEXT("ListSimilarNameAssets"), NumPackages, Density, [&Project, &SuperManager]()
+		{
+			TArray<TSharedPtr<FAssetData>> SimilarNameAssetsData;
+			SuperManager.ListSameNameAssetsForAssetList(Project.AssetsData, SimilarNameAssetsData, true);
+			return SimilarNameAssetsData.Num();
+		}
+	);
+}
+
+void USuperManagerBenchmarkCommandlet::RunProjectBenchmarks(bool bIncludeFixup)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	TArray<FAssetData> ProjectAssetsData;
+	AssetRegistry.GetAssetsByPath(FName(TEXT("/Game")), ProjectAssetsData, true);
+	const int32 NumPackages = ProjectAssetsData.Num();
+	ProjectAssetsData.Empty();
+
+	Measure(TEXT("GetAllAssetDataUnderSelectedFolder"), NumPackages, 0.f, [&SuperManager]()
+		{
+			return SuperManager.GetAllAssetDataUnderSelectedFolder({ TEXT("/Game") }).Num();
+		}
+	);
+
+	Measure(TEXT("EmptyFolderDetection"), NumPackages, 0.f, []()
+		{
+			FAssetFolderTree FolderTree;
+			FolderTree.Build(TEXT("/Game"));
+			return FolderTree.GetEmptyFoldersDeepestFirst().Num();
+		}
+	);
+
+	if (!bIncludeFixup)
+	{
+		return;
+	}
+
+	Measure(TEXT("FixUpRedirectors"), NumPackages, 0.f, [&SuperManager]()
+		{
+			bool bFixupCompleted = false;
+			SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+				TSet<FName>(),
+				{ TEXT("/Game") },
+				FSimpleDelegate::CreateLambda([&bFixupCompleted]()
+					{
+						bFixupCompleted = true;
+					}
+				)
+			);
+
+			// Nothing ticks the engine in a commandlet, so pump loading until the service calls back
+			while (!bFixupCompleted)
+			{
+				FlushAsyncLoading();
+				FTSTicker::GetCoreTicker().Tick(0.f);
+			}
+			return 0;
+		}
+	);
+}
+
+void USuperManagerBenchmarkCommandlet::Measure(const TCHAR* PathName, int32 NumPackages, float Density, TFunctionRef<int32()> Body)
+{
+	const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The peak is process-wide, so each path reports only how far it pushed the peak up
+	const int32 NumResults = Body();
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	const FPlatformMemoryStats MemoryAfter = FPlatformMemory::GetStats();
+
+	const FString CsvRow = FString::Printf(
+		TEXT("%s,%d,%.2f,%.4f,%.1f,%.1f,%d"),
+		PathName,
+		NumPackages,
+		Density,
+		ElapsedSeconds,
+		(static_cast<double>(MemoryAfter.PeakUsedPhysical) - static_cast<double>(MemoryBefore.PeakUsedPhysical)) / SuperManagerBenchmark::BytesPerMB,
+		(static_cast<double>(MemoryAfter.UsedPhysical) - static_cast<double>(MemoryBefore.UsedPhysical)) / SuperManagerBenchmark::BytesPerMB,
+		NumResults
+	);
+	DebugHeader::PrintLog(TEXT("SuperManagerBenchmark: ") + CsvRow);
+	CsvRows.Add(CsvRow);
+}
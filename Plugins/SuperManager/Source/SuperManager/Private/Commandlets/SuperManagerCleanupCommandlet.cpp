@@ -0,0 +1,619 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/SuperManagerCleanupCommandlet.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/AssetFolderTree.h"
+#include "AssetAnalysis/AssetNamingAudit.h"
+#include "AssetAnalysis/AssetReachabilityAnalyzer.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetActions/QuickAssetAction.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/ObjectRedirector.h"
+#include "Engine/World.h"
+#include "Settings/SuperManagerSettings.h"
+#include "DebugHeader.h"
+
+namespace CleanupReport
+{
+	const TCHAR* Roots = TEXT("Roots");
+	const TCHAR* UnusedAssets = TEXT("UnusedAssets");
+	const TCHAR* SameNameAssets = TEXT("SameNameAssets");
+	const TCHAR* EmptyFolders = TEXT("EmptyFolders");
+	const TCHAR* Redirectors = TEXT("Redirectors");
+	const TCHAR* NamingViolations = TEXT("NamingViolations");
+	// Only in shard reports: what the parent needs to build the graph without scanning those folders itself
+	const TCHAR* ShardAssets = TEXT("Assets");
+	const TCHAR* ShardPackageDependencies = TEXT("PackageDependencies");
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Strings)
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonValues;
+		JsonValues.Reserve(Strings.Num());
+		for (const FString& String : Strings)
+		{
+			JsonValues.Add(MakeShared<FJsonValueString>(String));
+		}
+		return JsonValues;
+	}
+
+	static void AppendArrayField(const TSharedRef<FJsonObject>& Report, const TCHAR* FieldName, const TArray<TSharedPtr<FJsonValue>>& Values)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ExistingValues = nullptr;
+		TArray<TSharedPtr<FJsonValue>> MergedValues;
+		if (Report->TryGetArrayField(FieldName, ExistingValues))
+		{
+			MergedValues = *ExistingValues;
+		}
+		MergedValues.Append(Values);
+		Report->SetArrayField(FieldName, MergedValues);
+	}
+
+	static int32 GetArrayFieldNum(const TSharedRef<FJsonObject>& Report, const TCHAR* FieldName)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		return Report->TryGetArrayField(FieldName, Values) ? Values->Num() : 0;
+	}
+}
+
+USuperManagerCleanupCommandlet::USuperManagerCleanupCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USuperManagerCleanupCommandlet::Main(const FString& Params)
+{
+	FString ReportFilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("CleanupReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportFilePath);
+	ReportFilePath = FPaths::ConvertRelativePathToFull(ReportFilePath);
+
+	FString RootsParam;
+	TArray<FString> ContentRoots;
+	if (FParse::Value(*Params, TEXT("Roots="), RootsParam, false))
+	{
+		RootsParam.ParseIntoArray(ContentRoots, TEXT("+"));
+		for (FString& ContentRoot : ContentRoots)
+		{
+			ContentRoot.RemoveFromEnd(TEXT("/"));
+		}
+	}
+	else
+	{
+		ContentRoots = FSuperManagerModule::GetProjectContentRoots();
+	}
+
+	FString ShardFolderListPath;
+	if (FParse::Value(*Params, TEXT("ShardFolderList="), ShardFolderListPath))
+	{
+		return RunAsShard(ShardFolderListPath, ContentRoots, ReportFilePath) ? 0 : 1;
+	}
+
+	int32 NumShards = 1;
+	FParse::Value(*Params, TEXT("Shards="), NumShards);
+	TArray<TArray<FString>> ShardFolders;
+	if (NumShards > 1)
+	{
+		ShardFolders = SplitIntoShards(NumShards);
+	}
+
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	TArray<FAssetData> AllAssetsData;
+	FAssetReferenceIndex ReferenceIndex;
+	FReachabilityRootRules RootRules;
+	bool bAllShardsSucceeded = true;
+	if (ShardFolders.Num() > 1)
+	{
+		// Reading package headers is the bulk of the work, and here it is split across the children.
+		// This process only gathers the packages sitting directly in a mounted root, which belong to no shard
+		TMap<FName, TArray<FName>> PackageDependencies;
+		bAllShardsSucceeded = RunShards(ShardFolders, ContentRoots, ReportFilePath, Report, AllAssetsData, PackageDependencies);
+		AddLooseRootPackages(AllAssetsData, PackageDependencies);
+		AddFolderSections(Report, ContentRoots, false);
+		ReferenceIndex.BuildFromDependencies(MoveTemp(PackageDependencies));
+
+		// Maps were gathered by the children, so the registry here can't list them
+		RootRules = SuperManager.GetReachabilityRootRules(ContentRoots);
+		if (GetDefault<USuperManagerSettings>()->bTreatMapsAsRoots)
+		{
+			const FTopLevelAssetPath WorldClassPath = UWorld::StaticClass()->GetClassPathName();
+			for (const FAssetData& AssetData : AllAssetsData)
+			{
+				if (AssetData.AssetClassPath == WorldClassPath)
+				{
+					RootRules.RootPackages.Add(AssetData.PackageName);
+				}
+			}
+		}
+	}
+	else
+	{
+		AssetRegistry.SearchAllAssets(true);
+		AssetRegistry.GetAllAssets(AllAssetsData, true);
+		ReferenceIndex.Build();
+		RootRules = SuperManager.GetReachabilityRootRules(ContentRoots);
+		AddFolderSections(Report, ContentRoots, true);
+	}
+
+	// A missing shard leaves holes in the graph, and anything it referenced would be reported as unused
+	if (bAllShardsSucceeded)
+	{
+		AddGraphSections(Report, ContentRoots, AllAssetsData, ReferenceIndex, FSuperManagerModule::CollectReachabilityRoots(ReferenceIndex, RootRules));
+	}
+	else
+	{
+		DebugHeader::PrintLog(TEXT("SuperManagerCleanup: a shard failed, so the unused and same-name sections are left out"));
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Redirectors = nullptr;
+	if (Report->TryGetArrayField(CleanupReport::Redirectors, Redirectors))
+	{
+		for (const TSharedPtr<FJsonValue>& Redirector : *Redirectors)
+		{
+			const TSharedPtr<FJsonObject>& RedirectorObject = Redirector->AsObject();
+			RedirectorObject->SetNumberField(
+				TEXT("Referencers"),
+				ReferenceIndex.GetReferencerCount(FName(RedirectorObject->GetStringField(TEXT("Redirector"))))
+			);
+		}
+	}
+	Report->SetArrayField(CleanupReport::Roots, CleanupReport::ToJsonArray(ContentRoots));
+
+	const TSharedPtr<FJsonObject>* SameNameAssets = nullptr;
+	DebugHeader::PrintLog(FString::Printf(
+		TEXT("SuperManagerCleanup: %d unused, %d same-name groups, %d empty folders, %d redirectors, %d naming violations"),
+		CleanupReport::GetArrayFieldNum(Report, CleanupReport::UnusedAssets),
+		Report->TryGetObjectField(CleanupReport::SameNameAssets, SameNameAssets) ? (*SameNameAssets)->Values.Num() : 0,
+		CleanupReport::GetArrayFieldNum(Report, CleanupReport::EmptyFolders),
+		CleanupReport::GetArrayFieldNum(Report, CleanupReport::Redirectors),
+		CleanupReport::GetArrayFieldNum(Report, CleanupReport::NamingViolations)
+	));
+
+	return SaveReport(Report, ReportFilePath) && bAllShardsSucceeded ? 0 : 1;
+}
+
+void USuperManagerCleanupCommandlet::AddGraphSections(
+	const TSharedRef<FJsonObject>& Report,
+	const TArray<FString>& ContentRoots,
+	const TArray<FAssetData>& AllAssetsData,
+	const FAssetReferenceIndex& ReferenceIndex,
+	const TSet<FName>& RootPackages
+)
+{
+	// Reachability needs the whole graph; only packages under the requested roots are deletion candidates
+	const TSet<FName> UnreachablePackages = FAssetReachabilityAnalyzer::FindUnreachablePackages(ReferenceIndex, RootPackages);
+
+	TArray<FString> UnusedAssets;
+	TMap<FName, TArray<FString>> AssetPathsByName;
+	TMap<FName, bool> RootFolderPathCache;
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		if (AssetData.IsRedirector() || FSuperManagerModule::IsRootFolderPackagePath(AssetData.PackagePath, RootFolderPathCache))
+		{
+			continue;
+		}
+
+		// Same-name groups are global; the report keeps every group that has at least one member under the roots
+		AssetPathsByName.FindOrAdd(AssetData.AssetName).Add(AssetData.GetObjectPathString());
+
+		if (UnreachablePackages.Contains(AssetData.PackageName) &&
+			IsUnderAnyContentRoot(AssetData.PackagePath.ToString(), ContentRoots))
+		{
+			UnusedAssets.Add(AssetData.GetObjectPathString());
+		}
+	}
+
+	TSharedRef<FJsonObject> SameNameAssets = MakeShared<FJsonObject>();
+	for (const TPair<FName, TArray<FString>>& AssetPaths : AssetPathsByName)
+	{
+		if (AssetPaths.Value.Num() < 2)
+		{
+			continue;
+		}
+
+		const bool bAnyUnderRoots = AssetPaths.Value.ContainsByPredicate([&ContentRoots](const FString& ObjectPath)
+			{
+				return IsUnderAnyContentRoot(FPackageName::GetLongPackagePath(ObjectPath), ContentRoots);
+			}
+		);
+		if (bAnyUnderRoots)
+		{
+			SameNameAssets->SetArrayField(AssetPaths.Key.ToString(), CleanupReport::ToJsonArray(AssetPaths.Value));
+		}
+	}
+
+	Report->SetArrayField(CleanupReport::UnusedAssets, CleanupReport::ToJsonArray(UnusedAssets));
+	Report->SetObjectField(CleanupReport::SameNameAssets, SameNameAssets);
+}
+
+void USuperManagerCleanupCommandlet::AddFolderSections(const TSharedRef<FJsonObject>& Report, const TArray<FString>& Folders, bool bRecursive)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FString> EmptyFolders;
+	if (bRecursive)
+	{
+		for (const FString& Folder : Folders)
+		{
+			FAssetFolderTree FolderTree;
+			FolderTree.Build(Folder);
+			for (const FString& EmptyFolderPath : FolderTree.GetEmptyFoldersDeepestFirst())
+			{
+				if (!FSuperManagerModule::IsRootFolderPath(EmptyFolderPath))
+				{
+					EmptyFolders.Add(EmptyFolderPath);
+				}
+			}
+
+			// A shard's folder is a sub-folder of a content root and may be empty itself; the roots never are
+			const bool bIsContentRoot = Folder.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1) == INDEX_NONE;
+			if (!bIsContentRoot && FolderTree.IsRootEmpty() && !FSuperManagerModule::IsRootFolderPath(Folder))
+			{
+				EmptyFolders.Add(Folder);
+			}
+		}
+	}
+
+	FARFilter RedirectorFilter;
+	RedirectorFilter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName());
+	RedirectorFilter.bRecursivePaths = bRecursive;
+	for (const FString& Folder : Folders)
+	{
+		RedirectorFilter.PackagePaths.Add(FName(Folder));
+	}
+	TArray<FAssetData> RedirectorsData;
+	if (RedirectorFilter.PackagePaths.Num() > 0)
+	{
+		AssetRegistry.GetAssets(RedirectorFilter, RedirectorsData);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Redirectors;
+	for (const FAssetData& RedirectorData : RedirectorsData)
+	{
+		TArray<FName> RedirectorTargets;
+		AssetRegistry.GetDependencies(RedirectorData.PackageName, RedirectorTargets, UE::AssetRegistry::EDependencyCategory::Package);
+
+		TSharedRef<FJsonObject> RedirectorObject = MakeShared<FJsonObject>();
+		RedirectorObject->SetStringField(TEXT("Redirector"), RedirectorData.PackageName.ToString());
+		RedirectorObject->SetStringField(TEXT("Target"), RedirectorTargets.Num() > 0 ? RedirectorTargets[0].ToString() : FString());
+		Redirectors.Add(MakeShared<FJsonValueObject>(RedirectorObject));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> NamingViolations;
+	for (const FAssetNamingViolation& Violation : FAssetNamingAudit::Run(GetDefault<UQuickAssetAction>()->GetPrefixMap(), Folders, nullptr, bRecursive))
+	{
+		TSharedRef<FJsonObject> ViolationObject = MakeShared<FJsonObject>();
+		ViolationObject->SetStringField(TEXT("Asset"), Violation.AssetData.GetObjectPathString());
+		ViolationObject->SetStringField(TEXT("Class"), Violation.AssetData.AssetClassPath.ToString());
+		ViolationObject->SetStringField(TEXT("ExpectedPrefix"), Violation.ExpectedPrefix);
+		ViolationObject->SetStringField(TEXT("SuggestedName"), Violation.SuggestedName);
+		NamingViolations.Add(MakeShared<FJsonValueObject>(ViolationObject));
+	}
+
+	CleanupReport::AppendArrayField(Report, CleanupReport::EmptyFolders, CleanupReport::ToJsonArray(EmptyFolders));
+	CleanupReport::AppendArrayField(Report, CleanupReport::Redirectors, Redirectors);
+	CleanupReport::AppendArrayField(Report, CleanupReport::NamingViolations, NamingViolations);
+}
+
+TArray<TArray<FString>> USuperManagerCleanupCommandlet::SplitIntoShards(int32 NumShards)
+{
+	// Every mounted root is split, not just the report roots: the graph needs the packages that reference into them too.
+	// The folders directly below each root are the unit of work, so a project that is all /Game still splits
+	TMap<FString, int32> FolderWeights;
+	for (const FString& MountedRoot : GetMountedContentRoots())
+	{
+		FString RootDirectory;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(MountedRoot + TEXT("/"), RootDirectory))
+		{
+			continue;
+		}
+
+		TArray<FString> SubDirectories;
+		IFileManager::Get().FindFiles(SubDirectories, *(RootDirectory / TEXT("*")), false, true);
+		for (const FString& SubDirectory : SubDirectories)
+		{
+			// Weighted by the files each folder holds; the registry here has not scanned anything yet
+			TArray<FString> SubDirectoryFiles;
+			IFileManager::Get().FindFilesRecursive(SubDirectoryFiles, *(RootDirectory / SubDirectory), TEXT("*"), true, false);
+			FolderWeights.Add(MountedRoot / SubDirectory, SubDirectoryFiles.Num() + 1);
+		}
+	}
+
+	FolderWeights.ValueSort([](int32 A, int32 B) { return A > B; });
+
+	// Heaviest first onto the lightest shard
+	TArray<TArray<FString>> ShardFolders;
+	TArray<int32> ShardWeights;
+	ShardFolders.SetNum(FMath::Clamp(NumShards, 1, FMath::Max(FolderWeights.Num(), 1)));
+	ShardWeights.SetNumZeroed(ShardFolders.Num());
+	for (const TPair<FString, int32>& FolderWeight : FolderWeights)
+	{
+		int32 LightestShardIndex = 0;
+		for (int32 ShardIndex = 1; ShardIndex < ShardWeights.Num(); ++ShardIndex)
+		{
+			if (ShardWeights[ShardIndex] < ShardWeights[LightestShardIndex])
+			{
+				LightestShardIndex = ShardIndex;
+			}
+		}
+		ShardFolders[LightestShardIndex].Add(FolderWeight.Key);
+		ShardWeights[LightestShardIndex] += FolderWeight.Value;
+	}
+	ShardFolders.RemoveAll([](const TArray<FString>& Folders) { return Folders.Num() == 0; });
+	return ShardFolders;
+}
+
+bool USuperManagerCleanupCommandlet::RunShards(
+	const TArray<TArray<FString>>& ShardFolders,
+	const TArray<FString>& ContentRoots,
+	const FString& ReportFilePath,
+	const TSharedRef<FJsonObject>& Report,
+	TArray<FAssetData>& OutAssetsData,
+	TMap<FName, TArray<FName>>& OutPackageDependencies
+)
+{
+	const FString ShardReportDir = FPaths::GetPath(ReportFilePath);
+	const FString ProjectFilePath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString RootsParam = FString::Join(ContentRoots, TEXT("+"));
+
+	TArray<FProcHandle> ShardProcesses;
+	TArray<FString> ShardReportPaths;
+	TArray<FString> ShardFolderListPaths;
+	for (int32 ShardIndex = 0; ShardIndex < ShardFolders.Num(); ++ShardIndex)
+	{
+		// A folder list can outgrow the command line, so it is handed over in a file
+		const FString ShardFolderListPath = ShardReportDir / FString::Printf(TEXT("CleanupShard%d_Folders.txt"), ShardIndex);
+		const FString ShardReportPath = ShardReportDir / FString::Printf(TEXT("CleanupReport_Shard%d.json"), ShardIndex);
+		if (!FFileHelper::SaveStringArrayToFile(ShardFolders[ShardIndex], *ShardFolderListPath))
+		{
+			DebugHeader::PrintLog(TEXT("SuperManagerCleanup: failed to write ") + ShardFolderListPath);
+			continue;
+		}
+
+		const FString ShardParams = FString::Printf(
+			TEXT("\"%s\" -run=SuperManagerCleanup -ShardFolderList=\"%s\" -Roots=\"%s\" -Report=\"%s\" -nullrhi -unattended -nopause -nosplash -stdout"),
+			*ProjectFilePath, *ShardFolderListPath, *RootsParam, *ShardReportPath
+		);
+
+		FProcHandle ShardProcess = FPlatformProcess::CreateProc(
+			FPlatformProcess::ExecutablePath(), *ShardParams, false, true, true, nullptr, 0, nullptr, nullptr
+		);
+		if (!ShardProcess.IsValid())
+		{
+			DebugHeader::PrintLog(TEXT("SuperManagerCleanup: failed to launch shard ") + FString::FromInt(ShardIndex));
+			IFileManager::Get().Delete(*ShardFolderListPath);
+			continue;
+		}
+		ShardProcesses.Add(ShardProcess);
+		ShardReportPaths.Add(ShardReportPath);
+		ShardFolderListPaths.Add(ShardFolderListPath);
+	}
+
+	bool bAllShardsSucceeded = ShardProcesses.Num() == ShardFolders.Num();
+	for (int32 ShardIndex = 0; ShardIndex < ShardProcesses.Num(); ++ShardIndex)
+	{
+		FPlatformProcess::WaitForProc(ShardProcesses[ShardIndex]);
+
+		int32 ReturnCode = 0;
+		FPlatformProcess::GetProcReturnCode(ShardProcesses[ShardIndex], &ReturnCode);
+		FPlatformProcess::CloseProc(ShardProcesses[ShardIndex]);
+		IFileManager::Get().Delete(*ShardFolderListPaths[ShardIndex]);
+
+		FString ShardReportString;
+		TSharedPtr<FJsonObject> ShardReport;
+		if (ReturnCode != 0 ||
+			!FFileHelper::LoadFileToString(ShardReportString, *ShardReportPaths[ShardIndex]) ||
+			!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ShardReportString), ShardReport) ||
+			!ShardReport.IsValid())
+		{
+			DebugHeader::PrintLog(TEXT("SuperManagerCleanup: shard failed, see ") + ShardReportPaths[ShardIndex]);
+			bAllShardsSucceeded = false;
+			continue;
+		}
+
+		for (const TCHAR* FieldName : { CleanupReport::EmptyFolders, CleanupReport::Redirectors, CleanupReport::NamingViolations })
+		{
+			const TArray<TSharedPtr<FJsonValue>>* ShardValues = nullptr;
+			if (ShardReport->TryGetArrayField(FieldName, ShardValues))
+			{
+				CleanupReport::AppendArrayField(Report, FieldName, *ShardValues);
+			}
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* ShardAssets = nullptr;
+		if (ShardReport->TryGetArrayField(CleanupReport::ShardAssets, ShardAssets))
+		{
+			OutAssetsData.Reserve(OutAssetsData.Num() + ShardAssets->Num());
+			for (const TSharedPtr<FJsonValue>& ShardAsset : *ShardAssets)
+			{
+				const TSharedPtr<FJsonObject>& AssetObject = ShardAsset->AsObject();
+				const FName PackageName(AssetObject->GetStringField(TEXT("Package")));
+				OutAssetsData.Emplace(
+					PackageName,
+					FName(FPackageName::GetLongPackagePath(PackageName.ToString())),
+					FName(AssetObject->GetStringField(TEXT("Name"))),
+					FTopLevelAssetPath(AssetObject->GetStringField(TEXT("Class")))
+				);
+			}
+		}
+
+		const TSharedPtr<FJsonObject>* ShardPackageDependencies = nullptr;
+		if (ShardReport->TryGetObjectField(CleanupReport::ShardPackageDependencies, ShardPackageDependencies))
+		{
+			OutPackageDependencies.Reserve(OutPackageDependencies.Num() + (*ShardPackageDependencies)->Values.Num());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& PackageDependency : (*ShardPackageDependencies)->Values)
+			{
+				TArray<FName>& Dependencies = OutPackageDependencies.Add(FName(PackageDependency.Key));
+				for (const TSharedPtr<FJsonValue>& Dependency : PackageDependency.Value->AsArray())
+				{
+					Dependencies.Add(FName(Dependency->AsString()));
+				}
+			}
+		}
+		IFileManager::Get().Delete(*ShardReportPaths[ShardIndex]);
+	}
+
+	return bAllShardsSucceeded;
+}
+
+void USuperManagerCleanupCommandlet::AddLooseRootPackages(TArray<FAssetData>& AssetsData, TMap<FName, TArray<FName>>& PackageDependencies)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	for (const FString& MountedRoot : GetMountedContentRoots())
+	{
+		FString RootDirectory;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(MountedRoot + TEXT("/"), RootDirectory))
+		{
+			continue;
+		}
+
+		TArray<FString> PackageFiles;
+		for (const FString& PackageExtension : { FPackageName::GetAssetPackageExtension(), FPackageName::GetMapPackageExtension() })
+		{
+			TArray<FString> Filenames;
+			IFileManager::Get().FindFiles(Filenames, *(RootDirectory / TEXT("*") + PackageExtension), true, false);
+			for (const FString& Filename : Filenames)
+			{
+				PackageFiles.Add(FPaths::ConvertRelativePathToFull(RootDirectory / Filename));
+			}
+		}
+		if (PackageFiles.Num() == 0)
+		{
+			continue;
+		}
+		AssetRegistry.ScanFilesSynchronous(PackageFiles);
+
+		TArray<FAssetData> RootAssetsData;
+		AssetRegistry.GetAssetsByPath(FName(MountedRoot), RootAssetsData, false, true);
+		for (const FAssetData& AssetData : RootAssetsData)
+		{
+			if (!PackageDependencies.Contains(AssetData.PackageName))
+			{
+				TArray<FName>& Dependencies = PackageDependencies.Add(AssetData.PackageName);
+				AssetRegistry.GetDependencies(AssetData.PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+			}
+		}
+		AssetsData.Append(RootAssetsData);
+	}
+}
+
+bool USuperManagerCleanupCommandlet::RunAsShard(const FString& ShardFolderListPath, const TArray<FString>& ContentRoots, const FString& ReportFilePath)
+{
+	TArray<FString> Folders;
+	if (!FFileHelper::LoadFileToStringArray(Folders, *ShardFolderListPath))
+	{
+		DebugHeader::PrintLog(TEXT("SuperManagerCleanup: failed to read ") + ShardFolderListPath);
+		return false;
+	}
+	Folders.RemoveAll([](const FString& Folder) { return Folder.IsEmpty(); });
+
+	// Only this shard's folders are scanned; the parent merges the graph and runs reachability over all of them
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.ScanPathsSynchronous(Folders, true);
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	for (const FString& Folder : Folders)
+	{
+		Filter.PackagePaths.Add(FName(Folder));
+	}
+	TArray<FAssetData> ShardAssetsData;
+	AssetRegistry.GetAssets(Filter, ShardAssetsData);
+
+	TArray<TSharedPtr<FJsonValue>> ShardAssets;
+	TSharedRef<FJsonObject> ShardPackageDependencies = MakeShared<FJsonObject>();
+	ShardAssets.Reserve(ShardAssetsData.Num());
+	TArray<FName> Dependencies;
+	TArray<FString> DependencyNames;
+	for (const FAssetData& AssetData : ShardAssetsData)
+	{
+		TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+		AssetObject->SetStringField(TEXT("Package"), AssetData.PackageName.ToString());
+		AssetObject->SetStringField(TEXT("Name"), AssetData.AssetName.ToString());
+		AssetObject->SetStringField(TEXT("Class"), AssetData.AssetClassPath.ToString());
+		ShardAssets.Add(MakeShared<FJsonValueObject>(AssetObject));
+
+		const FString PackageName = AssetData.PackageName.ToString();
+		if (ShardPackageDependencies->HasField(PackageName))
+		{
+			continue;
+		}
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(AssetData.PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		DependencyNames.Reset();
+		for (const FName& Dependency : Dependencies)
+		{
+			DependencyNames.Add(Dependency.ToString());
+		}
+		ShardPackageDependencies->SetArrayField(PackageName, CleanupReport::ToJsonArray(DependencyNames));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetArrayField(CleanupReport::Roots, CleanupReport::ToJsonArray(Folders));
+	Report->SetArrayField(CleanupReport::ShardAssets, ShardAssets);
+	Report->SetObjectField(CleanupReport::ShardPackageDependencies, ShardPackageDependencies);
+
+	// Folders outside the report roots are only here for the graph
+	const TArray<FString> ReportFolders = Folders.FilterByPredicate([&ContentRoots](const FString& Folder)
+		{
+			return IsUnderAnyContentRoot(Folder, ContentRoots);
+		}
+	);
+	if (ReportFolders.Num() > 0)
+	{
+		AddFolderSections(Report, ReportFolders, true);
+	}
+	return SaveReport(Report, ReportFilePath);
+}
+
+TArray<FString> USuperManagerCleanupCommandlet::GetMountedContentRoots()
+{
+	TArray<FString> MountedRoots;
+	FPackageName::QueryRootContentPaths(MountedRoots);
+	for (FString& MountedRoot : MountedRoots)
+	{
+		MountedRoot.RemoveFromEnd(TEXT("/"));
+	}
+	return MountedRoots;
+}
+
+bool USuperManagerCleanupCommandlet::IsUnderAnyContentRoot(const FString& PackagePath, const TArray<FString>& ContentRoots)
+{
+	for (const FString& ContentRoot : ContentRoots)
+	{
+		if (PackagePath.StartsWith(ContentRoot) &&
+			(PackagePath.Len() == ContentRoot.Len() || PackagePath[ContentRoot.Len()] == TEXT('/')))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool USuperManagerCleanupCommandlet::SaveReport(const TSharedRef<FJsonObject>& Report, const FString& ReportFilePath)
+{
+	FString ReportString;
+	if (!FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportString)))
+	{
+		return false;
+	}
+
+	const bool bSaved = FFileHelper::SaveStringToFile(ReportString, *ReportFilePath);
+	DebugHeader::PrintLog((bSaved ? TEXT("SuperManagerCleanup: report written to ") : TEXT("SuperManagerCleanup: failed to write ")) + ReportFilePath);
+	return bSaved;
+}
@@ -0,0 +1,9 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Settings/SuperManagerSettings.h"
+
+FName USuperManagerSettings::GetCategoryName() const
+{
+	return TEXT("Plugins");
+}
@@ -4,23 +4,100 @@
 #include "Slate/AdvanceDeletionWidget.h"
 #include "SuperManager.h"
 #include "EditorAssetLibrary.h"
+#include "AssetAnalysis/AssetContentHasher.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Layout/SBox.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "DebugHeader.h"
 
 #define LIST_ALL TEXT("List All Assets")
 #define LIST_UNUSED TEXT("List Unused Assets")
 #define LIST_SAME_NAME TEXT("List Same Name Assets")
+#define LIST_SIMILAR_NAME TEXT("List Similar Name Assets")
+#define LIST_DUPLICATE_CONTENT TEXT("List Duplicate Content Assets")
+
+namespace AssetListColumns
+{
+	const FName Check(TEXT("Check"));
+	const FName Class(TEXT("Class"));
+	const FName Name(TEXT("Name"));
+	const FName Size(TEXT("Size"));
+	const FName Referencers(TEXT("Referencers"));
+	const FName Dependencies(TEXT("Dependencies"));
+	const FName Modified(TEXT("Modified"));
+	const FName Delete(TEXT("Delete"));
+}
+
+namespace AssetFilterSlots
+{
+	const FName Preset(TEXT("Preset"));
+	const FName Class(TEXT("Class"));
+	const FName Path(TEXT("Path"));
+	const FName Tag(TEXT("Tag"));
+	const FName Size(TEXT("Size"));
+}
+
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateAssetCell, TSharedPtr<FAssetData>, const FName&);
+
+class SAdvanceDeletionAssetRow : public SMultiColumnTableRow<TSharedPtr<FAssetData>>
+{
+public:
+	SLATE_BEGIN_ARGS(SAdvanceDeletionAssetRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FAssetData>, AssetData)
+		SLATE_EVENT(FOnGenerateAssetCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		AssetData = InArgs._AssetData;
+		OnGenerateCell = InArgs._OnGenerateCell;
+		SMultiColumnTableRow<TSharedPtr<FAssetData>>::Construct(
+			FSuperRowType::FArguments().Padding(5.0f),
+			OwnerTable
+		);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			[
+				OnGenerateCell.Execute(AssetData, ColumnName)
+			];
+	}
+
+private:
+	TSharedPtr<FAssetData> AssetData;
+	FOnGenerateAssetCell OnGenerateCell;
+};
 
 void SAdvanceDeletionWidget::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 	StoredAssetsData = InArgs._AssetsDataToStore;
+	ListedAssetsData = StoredAssetsData;
 	DisplayedAssetsData = StoredAssetsData;
+	AssetFilterPipeline.SetAssetsData(StoredAssetsData);
+	AssetSearchIndex.Build(StoredAssetsData);
+	AssetMetricsCache = MakeShared<FAssetMetricsCache>();
+	AssetMetricsCache->OnMetricsUpdated().AddSP(this, &SAdvanceDeletionWidget::OnAssetMetricsUpdated);
 	FSlateFontInfo TitleTextFont = GetEmbossedTextFont();
 	TitleTextFont.Size = 30;
 
+	// Rows are generated while scrolling, so their fonts are built once here
+	AssetClassNameFont = GetEmbossedTextFont();
+	AssetClassNameFont.Size = 10.0f;
+	AssetNameFont = GetEmbossedTextFont();
+	AssetNameFont.Size = 15.0f;
+
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_ALL));
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_UNUSED));
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_SAME_NAME));
+	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_SIMILAR_NAME));
+	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_DUPLICATE_CONTENT));
 
 	ChildSlot
 	[
@@ -66,18 +143,30 @@ void SAdvanceDeletionWidget::Construct(const FArguments& InArgs)
 						]
 			]
 
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(5.0f)
+			[
+				ConstructFilterBar()
+			]
+
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(5.0f)
+			[
+				SNew(SSearchBox)
+					.HintText(FText::FromString(TEXT("Search names and paths, ^ for prefix")))
+					.OnTextChanged(this, &SAdvanceDeletionWidget::OnSearchTextChanged)
+			]
+
 			// for the asset list
 			+SVerticalBox::Slot()
 			.VAlign(VAlign_Fill)
 			[
-				SNew(SScrollBox)
-					+SScrollBox::Slot()
-					[
-						ConstructAssetListView()
-					]
+				ConstructAssetListView()
 			]
 
-			//for 3 buttons
+			//for 5 buttons
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
@@ -102,10 +191,48 @@ void SAdvanceDeletionWidget::Construct(const FArguments& InArgs)
 					[
 						ConstructDeselectAllButton()
 					]
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(10.f)
+					.Padding(5.0f)
+					[
+						ConstructInvertSelectionButton()
+					]
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(10.f)
+					.Padding(5.0f)
+					[
+						ConstructConsolidateButton()
+					]
 			]
 	];
 }
 
+void SAdvanceDeletionWidget::SetAssetsData(const TArray<TSharedPtr<FAssetData>>& AssetsDataToStore)
+{
+	StoredAssetsData = AssetsDataToStore;
+
+	// Filtering and searching keep the checked assets; only those no longer stored drop out
+	const TSet<TSharedPtr<FAssetData>> StoredAssetsDataSet(StoredAssetsData);
+	for (TSet<TSharedPtr<FAssetData>>::TIterator It = AssetsDataToDeleteSet.CreateIterator(); It; ++It)
+	{
+		if (!StoredAssetsDataSet.Contains(*It))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	AssetFilterPipeline.SetAssetsData(StoredAssetsData);
+	AssetFilterPipeline.SetStage(AssetFilterSlots::Preset, nullptr);
+	PresetListOrder.Empty();
+	AssetSearchIndex.Build(StoredAssetsData);
+	bListingDuplicateContent = false;
+	DuplicateContentGroups.Empty();
+	ComboDisplayTextBlock->SetText(FText::FromString(LIST_ALL));
+	ApplyFilterPipeline();
+}
+
 TSharedRef<ITableRow> SAdvanceDeletionWidget::OnGenerateRowForList(
 	TSharedPtr<FAssetData> AssetDataToDisplay,
 	const TSharedRef<STableViewBase>& OwnerTable
@@ -115,70 +242,222 @@ TSharedRef<ITableRow> SAdvanceDeletionWidget::OnGenerateRowForList(
 	{
 		return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable);
 	}
-	const FString DisplayAssetClassName = AssetDataToDisplay->AssetClassPath.GetAssetName().ToString();
-	const FString DisplayAssetName = AssetDataToDisplay->AssetName.ToString();
-	FSlateFontInfo AssetClassNameFont = GetEmbossedTextFont();
-	AssetClassNameFont.Size = 10.0f;
-	FSlateFontInfo AssetNameFont = GetEmbossedTextFont();
-	AssetNameFont.Size = 15.0f;
 
-	TSharedRef<STableRow<TSharedPtr<FAssetData>>> TableRow = SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable)
-		.Padding(5.0f)
-		[
-			SNew(SHorizontalBox)
-				+SHorizontalBox::Slot()
-					.HAlign(HAlign_Left)
-					.VAlign(VAlign_Fill)
-					.FillWidth(0.05f)
-					[
-						ConstructCheckBox(AssetDataToDisplay)
-					]
+	return SNew(SAdvanceDeletionAssetRow, OwnerTable)
+		.AssetData(AssetDataToDisplay)
+		.OnGenerateCell(this, &SAdvanceDeletionWidget::ConstructCellForColumn);
+}
 
-				+SHorizontalBox::Slot()
-					.HAlign(HAlign_Center)
-					.VAlign(VAlign_Center)
-					.FillWidth(0.55f)
-					[
-						ConstructTextForRowWidget(DisplayAssetClassName, AssetClassNameFont)
-					]
-					
+TSharedRef<SWidget> SAdvanceDeletionWidget::ConstructCellForColumn(TSharedPtr<FAssetData> AssetDataToDisplay, const FName& ColumnId)
+{
+	if (ColumnId == AssetListColumns::Check)
+	{
+		return ConstructCheckBox(AssetDataToDisplay);
+	}
+	if (ColumnId == AssetListColumns::Class)
+	{
+		return ConstructTextForRowWidget(AssetDataToDisplay->AssetClassPath.GetAssetName().ToString(), AssetClassNameFont);
+	}
+	if (ColumnId == AssetListColumns::Name)
+	{
+		return ConstructTextForRowWidget(AssetDataToDisplay->AssetName.ToString(), AssetNameFont);
+	}
+	if (ColumnId == AssetListColumns::Delete)
+	{
+		return ConstructButtonForRowWidget(AssetDataToDisplay);
+	}
 
-				+SHorizontalBox::Slot()
-					.HAlign(HAlign_Left)
-					.VAlign(VAlign_Center)
-					[
-						ConstructTextForRowWidget(DisplayAssetName, AssetNameFont)
-					]
-				+SHorizontalBox::Slot()
-					.HAlign(HAlign_Right)
-					.VAlign(VAlign_Fill)
-					[
-						ConstructButtonForRowWidget(AssetDataToDisplay)
-					]
-		];
+	// Metric cells poll the cache, so they fill in once the background worker gets to them
+	return SNew(STextBlock)
+		.Text(this, &SAdvanceDeletionWidget::GetMetricText, AssetDataToDisplay, ColumnId)
+		.ColorAndOpacity(FColor::White);
+}
+
+FText SAdvanceDeletionWidget::GetMetricText(TSharedPtr<FAssetData> AssetData, FName ColumnId) const
+{
+	FAssetMetrics Metrics;
+	if (!AssetMetricsCache->GetOrRequest(AssetData->PackageName, Metrics))
+	{
+		return FText::FromString(TEXT("..."));
+	}
 
-	return TableRow;
+	if (ColumnId == AssetListColumns::Size)
+	{
+		return Metrics.DiskSize >= 0 ? FText::AsMemory(Metrics.DiskSize) : FText::FromString(TEXT("-"));
+	}
+	if (ColumnId == AssetListColumns::Referencers)
+	{
+		return FText::AsNumber(Metrics.ReferencerCount);
+	}
+	if (ColumnId == AssetListColumns::Dependencies)
+	{
+		return FText::AsNumber(Metrics.DependencyCount);
+	}
+	if (ColumnId == AssetListColumns::Modified)
+	{
+		return Metrics.ModifiedTime > FDateTime::MinValue() ? FText::AsDateTime(Metrics.ModifiedTime) : FText::FromString(TEXT("-"));
+	}
+	return FText::GetEmpty();
 }
 
 TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionWidget::ConstructAssetListView()
 {
+	TSharedRef<SHeaderRow> AssetListHeaderRow = SNew(SHeaderRow)
+		+ SHeaderRow::Column(AssetListColumns::Check)
+			.DefaultLabel(FText::GetEmpty())
+			.FixedWidth(24.f);
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Class, TEXT("Class"), 0.15f));
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Name, TEXT("Name"), 0.3f));
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Size, TEXT("Size"), 0.1f));
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Referencers, TEXT("Referencers"), 0.1f));
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Dependencies, TEXT("Dependencies"), 0.1f));
+	AssetListHeaderRow->AddColumn(ConstructSortableColumn(AssetListColumns::Modified, TEXT("Modified"), 0.15f));
+	AssetListHeaderRow->AddColumn(
+		SHeaderRow::Column(AssetListColumns::Delete)
+			.DefaultLabel(FText::GetEmpty())
+			.FillWidth(0.1f)
+	);
+
 	ConstructedAssetListView = SNew(SListView<TSharedPtr<FAssetData>>)
 		.ListItemsSource(&DisplayedAssetsData)
 		.OnGenerateRow(this, &SAdvanceDeletionWidget::OnGenerateRowForList)
-		.OnMouseButtonDoubleClick(this, &SAdvanceDeletionWidget::OnRowClicked);
+		.OnMouseButtonDoubleClick(this, &SAdvanceDeletionWidget::OnRowClicked)
+		.HeaderRow(AssetListHeaderRow);
 
 	return ConstructedAssetListView.ToSharedRef();
 }
 
+SHeaderRow::FColumn::FArguments SAdvanceDeletionWidget::ConstructSortableColumn(const FName& ColumnId, const FString& Label, float FillWidth)
+{
+	return SHeaderRow::Column(ColumnId)
+		.DefaultLabel(FText::FromString(Label))
+		.FillWidth(FillWidth)
+		.SortMode(this, &SAdvanceDeletionWidget::GetColumnSortMode, ColumnId)
+		.OnSort(this, &SAdvanceDeletionWidget::OnColumnSortModeChanged);
+}
+
+EColumnSortMode::Type SAdvanceDeletionWidget::GetColumnSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SAdvanceDeletionWidget::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
+
+	if (IsMetricColumn(SortColumnId))
+	{
+		// Sort on what is cached now and again once the missing metrics are in
+		TArray<FName> PackageNames;
+		PackageNames.Reserve(DisplayedAssetsData.Num());
+		for (const TSharedPtr<FAssetData>& AssetData : DisplayedAssetsData)
+		{
+			PackageNames.Add(AssetData->PackageName);
+		}
+		AssetMetricsCache->Request(PackageNames);
+	}
+
+	SortDisplayedAssets();
+	ConstructedAssetListView->RequestListRefresh();
+}
+
+void SAdvanceDeletionWidget::OnAssetMetricsUpdated()
+{
+	if (IsMetricColumn(SortColumnId) && SortMode != EColumnSortMode::None)
+	{
+		SortDisplayedAssets();
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+bool SAdvanceDeletionWidget::IsMetricColumn(FName ColumnId)
+{
+	return ColumnId == AssetListColumns::Size ||
+		ColumnId == AssetListColumns::Referencers ||
+		ColumnId == AssetListColumns::Dependencies ||
+		ColumnId == AssetListColumns::Modified;
+}
+
+void SAdvanceDeletionWidget::SortDisplayedAssets()
+{
+	if (SortMode == EColumnSortMode::None || SortColumnId.IsNone())
+	{
+		return;
+	}
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+
+	if (SortColumnId == AssetListColumns::Class || SortColumnId == AssetListColumns::Name)
+	{
+		const bool bByClass = SortColumnId == AssetListColumns::Class;
+		DisplayedAssetsData.StableSort([bAscending, bByClass](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+			{
+				const int32 Compare = bByClass ?
+					A->AssetClassPath.GetAssetName().Compare(B->AssetClassPath.GetAssetName()) :
+					A->AssetName.Compare(B->AssetName);
+				return bAscending ? Compare < 0 : Compare > 0;
+			}
+		);
+		return;
+	}
+
+	// One cache lookup per row up front instead of one per comparison; rows still waiting on metrics go last
+	struct FSortEntry
+	{
+		int64 Key;
+		bool bKnown;
+		TSharedPtr<FAssetData> AssetData;
+	};
+	TArray<FSortEntry> SortEntries;
+	SortEntries.Reserve(DisplayedAssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : DisplayedAssetsData)
+	{
+		FAssetMetrics Metrics;
+		const bool bKnown = AssetMetricsCache->GetOrRequest(AssetData->PackageName, Metrics);
+		int64 Key = 0;
+		if (SortColumnId == AssetListColumns::Size)
+		{
+			Key = Metrics.DiskSize;
+		}
+		else if (SortColumnId == AssetListColumns::Referencers)
+		{
+			Key = Metrics.ReferencerCount;
+		}
+		else if (SortColumnId == AssetListColumns::Dependencies)
+		{
+			Key = Metrics.DependencyCount;
+		}
+		else
+		{
+			Key = Metrics.ModifiedTime.GetTicks();
+		}
+		SortEntries.Add({ Key, bKnown, AssetData });
+	}
+
+	SortEntries.StableSort([bAscending](const FSortEntry& A, const FSortEntry& B)
+		{
+			if (A.bKnown != B.bKnown)
+			{
+				return A.bKnown;
+			}
+			return bAscending ? A.Key < B.Key : A.Key > B.Key;
+		}
+	);
+
+	for (int32 EntryIndex = 0; EntryIndex < SortEntries.Num(); ++EntryIndex)
+	{
+		DisplayedAssetsData[EntryIndex] = MoveTemp(SortEntries[EntryIndex].AssetData);
+	}
+}
+
 TSharedRef<SCheckBox> SAdvanceDeletionWidget::ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay)
 {
-	TSharedRef<SCheckBox> CheckBoxRef = SNew(SCheckBox)
+	// The row only reflects the selection, so a regenerated row shows the right state
+	return SNew(SCheckBox)
 		.Type(ESlateCheckBoxType::CheckBox)
+		.IsChecked(this, &SAdvanceDeletionWidget::GetCheckBoxState, AssetDataToDisplay)
 		.OnCheckStateChanged(this, &SAdvanceDeletionWidget::OnCheckBoxStateChange, AssetDataToDisplay)
 		.Visibility(EVisibility::Visible);
-
-	CheckBoxesArray.Add(CheckBoxRef);
-	return CheckBoxRef;
 }
 
 TSharedRef<STextBlock> SAdvanceDeletionWidget::ConstructTextForRowWidget(
@@ -243,6 +522,27 @@ TSharedRef<SButton> SAdvanceDeletionWidget::ConstructDeselectAllButton()
 	return DeselectAllButton;
 }
 
+TSharedRef<SButton> SAdvanceDeletionWidget::ConstructInvertSelectionButton()
+{
+	TSharedRef<SButton> InvertSelectionButton = ConstructTabButton();
+	InvertSelectionButton->SetOnClicked(FOnClicked::CreateLambda([this]() { return OnInvertSelectionButtonClicked(); }));
+	InvertSelectionButton->SetContent(ConstructTextForTabButtons(TEXT("Invert Selection")));
+	return InvertSelectionButton;
+}
+
+TSharedRef<SButton> SAdvanceDeletionWidget::ConstructConsolidateButton()
+{
+	TSharedRef<SButton> ConsolidateButton = ConstructTabButton();
+	ConsolidateButton->SetOnClicked(FOnClicked::CreateLambda([this]() { return OnConsolidateButtonClicked(); }));
+	ConsolidateButton->SetContent(ConstructTextForTabButtons(TEXT("Consolidate Duplicates")));
+	ConsolidateButton->SetEnabled(TAttribute<bool>::CreateLambda([this]()
+		{
+			return bListingDuplicateContent && DuplicateContentGroups.Num() > 0;
+		}
+	));
+	return ConsolidateButton;
+}
+
 TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvanceDeletionWidget::ConstructComboBox()
 {
 	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructedComboBox =
@@ -257,6 +557,69 @@ TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvanceDeletionWidget::ConstructComb
 	return ConstructedComboBox;
 }
 
+TSharedRef<SWidget> SAdvanceDeletionWidget::ConstructFilterBar()
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		[
+			ConstructFilterTextBox(AssetFilterSlots::Class, TEXT("Class"), TEXT("Texture2D, StaticMesh"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		[
+			ConstructFilterTextBox(AssetFilterSlots::Path, TEXT("Path"), TEXT("/Game/Props/*"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		[
+			ConstructFilterTextBox(AssetFilterSlots::Tag, TEXT("Tag"), TEXT("Tag=Value"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		[
+			ConstructFilterTextBox(AssetFilterSlots::Size, TEXT("Size"), TEXT("Min-Max KB"))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(5.0f, 0.f)
+		[
+			SNew(SCheckBox)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+					{
+						AssetFilterPipeline.SetCombineMode(NewState == ECheckBoxState::Checked ?
+							EAssetFilterCombineMode::MatchAny : EAssetFilterCombineMode::MatchAll);
+						ApplyFilterPipeline();
+					}
+				)
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(TEXT("Match any")))
+				]
+		];
+}
+
+TSharedRef<SWidget> SAdvanceDeletionWidget::ConstructFilterTextBox(FName SlotName, const FString& Label, const FString& HintText)
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(5.0f, 0.f)
+		[
+			SNew(STextBlock)
+				.Text(FText::FromString(Label))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.f)
+		[
+			SNew(SEditableTextBox)
+				.HintText(FText::FromString(HintText))
+				.OnTextCommitted(this, &SAdvanceDeletionWidget::OnFilterTextCommitted, SlotName)
+		];
+}
+
 TSharedRef<STextBlock> SAdvanceDeletionWidget::ConstructHelpTextBlock(const FString& HelpText, ETextJustify::Type TextJustify)
 {
 	return SNew(STextBlock)
@@ -271,13 +634,10 @@ void SAdvanceDeletionWidget::OnCheckBoxStateChange(ECheckBoxState NewState, TSha
 	switch (NewState)
 	{
 	case ECheckBoxState::Unchecked:
-		if (AssetsDataToDeleteArray.Contains(AssetData))
-		{
-			AssetsDataToDeleteArray.Remove(AssetData);
-		}
+		AssetsDataToDeleteSet.Remove(AssetData);
 		break;
 	case ECheckBoxState::Checked:
-		AssetsDataToDeleteArray.AddUnique(AssetData);
+		AssetsDataToDeleteSet.Add(AssetData);
 		break;
 	case ECheckBoxState::Undetermined:
 		break;
@@ -286,6 +646,11 @@ void SAdvanceDeletionWidget::OnCheckBoxStateChange(ECheckBoxState NewState, TSha
 	}
 }
 
+ECheckBoxState SAdvanceDeletionWidget::GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const
+{
+	return AssetsDataToDeleteSet.Contains(AssetData) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
 void SAdvanceDeletionWidget::OnRowClicked(TSharedPtr<FAssetData> AssetData)
 {
 	TArray<FString> AssetPath;
@@ -296,67 +661,151 @@ void SAdvanceDeletionWidget::OnRowClicked(TSharedPtr<FAssetData> AssetData)
 FReply SAdvanceDeletionWidget::OnDeleteButtonClicked(const TSharedPtr<FAssetData>& AssetDataToDisply)
 {
 	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-	SuperManager.FixUpRedirectors();
-	if (SuperManager.DeleteSingleAssetForAssetList(*AssetDataToDisply))
-	{
-		StoredAssetsData.Remove(AssetDataToDisply);
-		DisplayedAssetsData.Remove(AssetDataToDisply);
-		RefreshAssetListView();
-	}
+	TSet<FName> ScopePackageNames;
+	ScopePackageNames.Add(AssetDataToDisply->PackageName);
+	SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+		ScopePackageNames,
+		TArray<FString>(),
+		FSimpleDelegate::CreateSP(this, &SAdvanceDeletionWidget::DeleteSingleAsset, AssetDataToDisply)
+	);
 	return FReply::Handled();
 }
 
 FReply SAdvanceDeletionWidget::OnDeleteAllButtonClicked()
 {
-	if (AssetsDataToDeleteArray.Num() == 0)
+	if (AssetsDataToDeleteSet.Num() == 0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset currently selected"));
 	}
 	else
 	{
 		FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-		SuperManager.FixUpRedirectors();
+		TSet<FName> ScopePackageNames;
+		for (const TSharedPtr<FAssetData>& AssetRef : AssetsDataToDeleteSet)
+		{
+			ScopePackageNames.Add(AssetRef->PackageName);
+		}
+		SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+			ScopePackageNames,
+			TArray<FString>(),
+			FSimpleDelegate::CreateSP(this, &SAdvanceDeletionWidget::DeleteSelectedAssets)
+		);
+	}
+	return FReply::Handled();
+}
+
+void SAdvanceDeletionWidget::DeleteSingleAsset(TSharedPtr<FAssetData> AssetDataToDelete)
+{
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	if (SuperManager.DeleteSingleAssetForAssetList(*AssetDataToDelete))
+	{
+		TSet<FName> CandidatePackageNames;
+		CandidatePackageNames.Add(AssetDataToDelete->PackageName);
+		RemoveDeletedAssetsFromLists(CandidatePackageNames);
+	}
+}
+
+void SAdvanceDeletionWidget::DeleteSelectedAssets()
+{
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	TArray<FAssetData> AssetDataToDelete;
+	TSet<FName> CandidatePackageNames;
+	AssetDataToDelete.Reserve(AssetsDataToDeleteSet.Num());
+	CandidatePackageNames.Reserve(AssetsDataToDeleteSet.Num());
+	for (const TSharedPtr<FAssetData>& AssetRef : AssetsDataToDeleteSet)
+	{
+		AssetDataToDelete.Add(*AssetRef);
+		CandidatePackageNames.Add(AssetRef->PackageName);
+	}
 
-		TArray<FAssetData> AssetDataToDelete;
-		for (TSharedPtr<FAssetData> AssetRef : AssetsDataToDeleteArray)
+	if (SuperManager.DeleteMultipleAssetsForAssetList(AssetDataToDelete))
+	{
+		RemoveDeletedAssetsFromLists(CandidatePackageNames);
+	}
+}
+
+void SAdvanceDeletionWidget::RemoveDeletedAssetsFromLists(const TSet<FName>& CandidatePackageNames)
+{
+	// Deletion can stop part way, so only packages that are gone from the registry leave the lists
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	TSet<FName> DeletedPackageNames;
+	TArray<FAssetData> PackageAssetsData;
+	for (const FName& PackageName : CandidatePackageNames)
+	{
+		PackageAssetsData.Reset();
+		AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssetsData);
+		if (PackageAssetsData.Num() == 0)
 		{
-			AssetDataToDelete.Add(*AssetRef);
+			DeletedPackageNames.Add(PackageName);
 		}
+	}
+	if (DeletedPackageNames.Num() == 0)
+	{
+		return;
+	}
 
-		if (SuperManager.DeleteMultipleAssetsForAssetList(AssetDataToDelete))
+	auto IsDeleted = [&DeletedPackageNames](const TSharedPtr<FAssetData>& AssetData)
 		{
-			for (const TSharedPtr<FAssetData>& DeletedAsset : AssetsDataToDeleteArray)
-			{
-				StoredAssetsData.Remove(DeletedAsset);
-				DisplayedAssetsData.Remove(DeletedAsset);
-			}
-			RefreshAssetListView();
+			return DeletedPackageNames.Contains(AssetData->PackageName);
+		};
+	for (const FName& DeletedPackageName : DeletedPackageNames)
+	{
+		AssetMetricsCache->Invalidate(DeletedPackageName);
+	}
+	StoredAssetsData.RemoveAll(IsDeleted);
+	AssetFilterPipeline.RemoveAssetsData(DeletedPackageNames);
+	AssetSearchIndex.RemoveAssetsData(DeletedPackageNames);
+	ListedAssetsData.RemoveAll(IsDeleted);
+	DisplayedAssetsData.RemoveAll(IsDeleted);
+	for (TSet<TSharedPtr<FAssetData>>::TIterator It = AssetsDataToDeleteSet.CreateIterator(); It; ++It)
+	{
+		if (IsDeleted(*It))
+		{
+			It.RemoveCurrent();
 		}
 	}
-	return FReply::Handled();
+	for (TArray<TSharedPtr<FAssetData>>& DuplicateGroup : DuplicateContentGroups)
+	{
+		DuplicateGroup.RemoveAll(IsDeleted);
+	}
+	DuplicateContentGroups.RemoveAll([](const TArray<TSharedPtr<FAssetData>>& DuplicateGroup)
+		{
+			return DuplicateGroup.Num() < 2;
+		}
+	);
+
+	RefreshAssetListView();
 }
 
 FReply SAdvanceDeletionWidget::OnSelectAllButtonClicked()
 {
-	for (const TSharedRef<SCheckBox>& CheckBox : CheckBoxesArray)
+	AssetsDataToDeleteSet.Reserve(DisplayedAssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : DisplayedAssetsData)
 	{
-		if (!CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}
+		AssetsDataToDeleteSet.Add(AssetData);
 	}
 	return FReply::Handled();
 }
 
 FReply SAdvanceDeletionWidget::OnDeselectAllButtonClicked()
 {
-	for (const TSharedRef<SCheckBox>& CheckBox : CheckBoxesArray)
+	AssetsDataToDeleteSet.Empty();
+	return FReply::Handled();
+}
+
+FReply SAdvanceDeletionWidget::OnInvertSelectionButtonClicked()
+{
+	TSet<TSharedPtr<FAssetData>> InvertedSelection;
+	InvertedSelection.Reserve(DisplayedAssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : DisplayedAssetsData)
 	{
-		if (CheckBox->IsChecked())
+		if (!AssetsDataToDeleteSet.Contains(AssetData))
 		{
-			CheckBox->ToggleCheckedState();
+			InvertedSelection.Add(AssetData);
 		}
 	}
+	AssetsDataToDeleteSet = MoveTemp(InvertedSelection);
 	return FReply::Handled();
 }
 
@@ -371,28 +820,325 @@ void SAdvanceDeletionWidget::OnComboSelectionChanged(TSharedPtr<FString> Selecte
 	ComboDisplayTextBlock->SetText(FText::FromString(*SelectedOption.Get()));
 
 	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	bListingDuplicateContent = *SelectedOption == LIST_DUPLICATE_CONTENT;
+	DuplicateContentGroups.Empty();
+
+	// Each option is one stage of the pipeline, combined with whatever the filter bar holds
 	if (*SelectedOption == LIST_ALL)
 	{
-		DisplayedAssetsData = StoredAssetsData;
+		AssetFilterPipeline.SetStage(AssetFilterSlots::Preset, nullptr);
+		PresetListOrder.Empty();
+		ApplyFilterPipeline();
+		return;
 	}
-	else if (*SelectedOption == LIST_UNUSED)
+
+	TArray<TSharedPtr<FAssetData>> PresetAssetsData;
+	if (*SelectedOption == LIST_UNUSED)
 	{
-		SuperManager.ListUnusedAssetsForAssetList(StoredAssetsData, DisplayedAssetsData);
+		SuperManager.ListUnusedAssetsForAssetList(StoredAssetsData, PresetAssetsData);
 	}
 	else if (*SelectedOption == LIST_SAME_NAME)
 	{
-		SuperManager.ListSameNameAssetsForAssetList(StoredAssetsData, DisplayedAssetsData);
+		SuperManager.ListSameNameAssetsForAssetList(StoredAssetsData, PresetAssetsData);
+	}
+	else if (*SelectedOption == LIST_SIMILAR_NAME)
+	{
+		SuperManager.ListSameNameAssetsForAssetList(StoredAssetsData, PresetAssetsData, true);
+	}
+	else if (*SelectedOption == LIST_DUPLICATE_CONTENT)
+	{
+		// Lists nothing until the hashing is done
+		ListDuplicateContentAssets();
+	}
+
+	SetPresetStage(PresetAssetsData);
+	ApplyFilterPipeline();
+}
+
+void SAdvanceDeletionWidget::ListDuplicateContentAssets()
+{
+	TSharedRef<TArray<TArray<TSharedPtr<FAssetData>>>> FoundGroups = MakeShared<TArray<TArray<TSharedPtr<FAssetData>>>>();
+	TWeakPtr<SAdvanceDeletionWidget> WeakThis = StaticCastSharedRef<SAdvanceDeletionWidget>(AsShared());
+
+	// Hashing reads every candidate package from disk, so the list is filled in once it is done
+	FAssetScanTask::Launch(
+		FText::FromString(TEXT("Hash asset content")),
+		[AssetsDataToHash = StoredAssetsData, FoundGroups](FAssetScanTask& ScanTask)
+		{
+			*FoundGroups = FAssetContentHasher::FindDuplicateContent(AssetsDataToHash, &ScanTask);
+		},
+		[WeakThis, FoundGroups]()
+		{
+			TSharedPtr<SAdvanceDeletionWidget> PinnedThis = WeakThis.Pin();
+			if (!PinnedThis.IsValid() || !PinnedThis->bListingDuplicateContent)
+			{
+				return;
+			}
+
+			PinnedThis->DuplicateContentGroups = MoveTemp(*FoundGroups);
+			TArray<TSharedPtr<FAssetData>> DuplicateAssetsData;
+			for (const TArray<TSharedPtr<FAssetData>>& DuplicateGroup : PinnedThis->DuplicateContentGroups)
+			{
+				DuplicateAssetsData.Append(DuplicateGroup);
+			}
+			PinnedThis->SetPresetStage(DuplicateAssetsData);
+			PinnedThis->ApplyFilterPipeline();
+		}
+	);
+}
+
+FReply SAdvanceDeletionWidget::OnConsolidateButtonClicked()
+{
+	if (!bListingDuplicateContent || DuplicateContentGroups.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("List duplicate content assets first"), false);
+		return FReply::Handled();
+	}
+
+	int32 NumToConsolidate = 0;
+	for (const TArray<TSharedPtr<FAssetData>>& DuplicateGroup : DuplicateContentGroups)
+	{
+		NumToConsolidate += DuplicateGroup.Num() - 1;
+	}
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(
+		EAppMsgType::YesNo,
+		TEXT("Consolidate ") + FString::FromInt(NumToConsolidate) + TEXT(" duplicates into ") +
+		FString::FromInt(DuplicateContentGroups.Num()) + TEXT(" assets?\nReferences are moved to the first asset of each group."),
+		false
+	);
+	if (ConfirmResult == EAppReturnType::No)
+	{
+		return FReply::Handled();
+	}
+
+	// Consolidation cannot be undone, so every duplicate is compared byte for byte with the asset it merges into
+	TSharedRef<TArray<TArray<TSharedPtr<FAssetData>>>> VerifiedGroups = MakeShared<TArray<TArray<TSharedPtr<FAssetData>>>>();
+	TWeakPtr<SAdvanceDeletionWidget> WeakThis = StaticCastSharedRef<SAdvanceDeletionWidget>(AsShared());
+	FAssetScanTask::Launch(
+		FText::FromString(TEXT("Verify duplicate content")),
+		[DuplicateGroups = DuplicateContentGroups, VerifiedGroups](FAssetScanTask& ScanTask)
+		{
+			for (int32 GroupIndex = 0; GroupIndex < DuplicateGroups.Num(); ++GroupIndex)
+			{
+				if (ScanTask.IsCancelled())
+				{
+					return;
+				}
+				ScanTask.SetProgress(GroupIndex, DuplicateGroups.Num());
+
+				const TArray<TSharedPtr<FAssetData>>& DuplicateGroup = DuplicateGroups[GroupIndex];
+				TArray<TSharedPtr<FAssetData>> VerifiedGroup = { DuplicateGroup[0] };
+				for (int32 DuplicateIndex = 1; DuplicateIndex < DuplicateGroup.Num(); ++DuplicateIndex)
+				{
+					if (FAssetContentHasher::HaveIdenticalContent(*DuplicateGroup[0], *DuplicateGroup[DuplicateIndex]))
+					{
+						VerifiedGroup.Add(DuplicateGroup[DuplicateIndex]);
+					}
+					else
+					{
+						DebugHeader::PrintLog(DuplicateGroup[DuplicateIndex]->GetObjectPathString() +
+							TEXT(" differs from ") + DuplicateGroup[0]->GetObjectPathString() + TEXT(" and is not consolidated"));
+					}
+				}
+				if (VerifiedGroup.Num() > 1)
+				{
+					VerifiedGroups->Add(MoveTemp(VerifiedGroup));
+				}
+			}
+		},
+		[WeakThis, VerifiedGroups]()
+		{
+			if (TSharedPtr<SAdvanceDeletionWidget> PinnedThis = WeakThis.Pin())
+			{
+				PinnedThis->ConsolidateDuplicateGroups(*VerifiedGroups);
+			}
+		}
+	);
+	return FReply::Handled();
+}
+
+void SAdvanceDeletionWidget::ConsolidateDuplicateGroups(const TArray<TArray<TSharedPtr<FAssetData>>>& VerifiedGroups)
+{
+	if (VerifiedGroups.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No duplicates are byte-for-byte identical, nothing was consolidated"), false);
+		return;
+	}
+
+	TSet<FName> ConsolidatedPackageNames;
+	TSet<FName> ScopePackageNames;
+	for (const TArray<TSharedPtr<FAssetData>>& DuplicateGroup : VerifiedGroups)
+	{
+		UObject* AssetToKeep = DuplicateGroup[0]->GetAsset();
+		if (!AssetToKeep)
+		{
+			continue;
+		}
+
+		TArray<UObject*> AssetsToConsolidate;
+		for (int32 GroupIndex = 1; GroupIndex < DuplicateGroup.Num(); ++GroupIndex)
+		{
+			if (UObject* DuplicateAsset = DuplicateGroup[GroupIndex]->GetAsset())
+			{
+				AssetsToConsolidate.Add(DuplicateAsset);
+			}
+		}
+
+		if (AssetsToConsolidate.Num() > 0 && UEditorAssetLibrary::ConsolidateAssets(AssetToKeep, AssetsToConsolidate))
+		{
+			ScopePackageNames.Add(DuplicateGroup[0]->PackageName);
+			for (int32 GroupIndex = 1; GroupIndex < DuplicateGroup.Num(); ++GroupIndex)
+			{
+				ConsolidatedPackageNames.Add(DuplicateGroup[GroupIndex]->PackageName);
+			}
+		}
+	}
+	ScopePackageNames.Append(ConsolidatedPackageNames);
+
+	// Consolidation leaves redirectors behind; once they are fixed up the duplicates are gone from the registry
+	FSuperManagerModule& SuperManager = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManager.GetRedirectorFixupService().FixUpRedirectors(
+		ScopePackageNames,
+		TArray<FString>(),
+		FSimpleDelegate::CreateSP(this, &SAdvanceDeletionWidget::OnDuplicatesConsolidated, ConsolidatedPackageNames)
+	);
+}
+
+void SAdvanceDeletionWidget::OnDuplicatesConsolidated(TSet<FName> ConsolidatedPackageNames)
+{
+	DuplicateContentGroups.Empty();
+	if (bListingDuplicateContent)
+	{
+		SetPresetStage(TArray<TSharedPtr<FAssetData>>());
+	}
+	RemoveDeletedAssetsFromLists(ConsolidatedPackageNames);
+	ApplyFilterPipeline();
+}
+
+void SAdvanceDeletionWidget::OnFilterTextCommitted(const FText& InFilterText, ETextCommit::Type CommitType, FName SlotName)
+{
+	// Only the stage in this slot loses its cached results
+	AssetFilterPipeline.SetStage(SlotName, MakeFilterStage(SlotName, InFilterText.ToString().TrimStartAndEnd()));
+	ApplyFilterPipeline();
+}
+
+TSharedPtr<FAssetFilterStage> SAdvanceDeletionWidget::MakeFilterStage(FName SlotName, const FString& FilterText)
+{
+	if (FilterText.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	if (SlotName == AssetFilterSlots::Class)
+	{
+		TArray<FString> ClassNames;
+		FilterText.ParseIntoArray(ClassNames, TEXT(","));
+		return MakeShared<FAssetClassFilterStage>(ClassNames);
+	}
+	if (SlotName == AssetFilterSlots::Path)
+	{
+		return MakeShared<FAssetPathGlobFilterStage>(FilterText);
+	}
+	if (SlotName == AssetFilterSlots::Tag)
+	{
+		FString TagName;
+		FString TagValue;
+		if (!FilterText.Split(TEXT("="), &TagName, &TagValue))
+		{
+			TagName = FilterText;
+		}
+		return MakeShared<FAssetTagValueFilterStage>(FName(*TagName.TrimStartAndEnd()), TagValue.TrimStartAndEnd());
+	}
+	if (SlotName == AssetFilterSlots::Size)
+	{
+		// "100-" and "-500" leave the other end open
+		FString MinText;
+		FString MaxText;
+		if (!FilterText.Split(TEXT("-"), &MinText, &MaxText))
+		{
+			MinText = FilterText;
+		}
+		MinText.TrimStartAndEndInline();
+		MaxText.TrimStartAndEndInline();
+		const int64 MinSize = MinText.IsEmpty() ? 0 : static_cast<int64>(FCString::Atod(*MinText) * 1024.0);
+		const int64 MaxSize = MaxText.IsEmpty() ? MAX_int64 : static_cast<int64>(FCString::Atod(*MaxText) * 1024.0);
+		return MakeShared<FAssetSizeRangeFilterStage>(MinSize, MaxSize);
+	}
+	return nullptr;
+}
+
+void SAdvanceDeletionWidget::SetPresetStage(const TArray<TSharedPtr<FAssetData>>& PresetAssetsData)
+{
+	TSet<FName> PresetPackageNames;
+	PresetPackageNames.Reserve(PresetAssetsData.Num());
+	PresetListOrder.Empty(PresetAssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : PresetAssetsData)
+	{
+		PresetPackageNames.Add(AssetData->PackageName);
+		PresetListOrder.Add(AssetData, PresetListOrder.Num());
+	}
+	AssetFilterPipeline.SetStage(AssetFilterSlots::Preset, MakeShared<FAssetPackageSetFilterStage>(MoveTemp(PresetPackageNames)));
+}
+
+void SAdvanceDeletionWidget::ApplyFilterPipeline()
+{
+	ListedAssetsData = AssetFilterPipeline.Evaluate();
+	bListingAllAssets = !AssetFilterPipeline.HasStages();
+
+	if (PresetListOrder.Num() > 0)
+	{
+		// With "Match any" assets outside the preset can pass too; they go after it
+		auto GetListOrder = [this](const TSharedPtr<FAssetData>& AssetData)
+			{
+				const int32* ListOrder = PresetListOrder.Find(AssetData);
+				return ListOrder ? *ListOrder : MAX_int32;
+			};
+		ListedAssetsData.StableSort([&GetListOrder](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+			{
+				return GetListOrder(A) < GetListOrder(B);
+			}
+		);
+	}
+
+	ApplySearchFilter();
+}
+
+void SAdvanceDeletionWidget::OnSearchTextChanged(const FText& InSearchText)
+{
+	SearchText = InSearchText.ToString();
+	ApplySearchFilter();
+}
+
+void SAdvanceDeletionWidget::ApplySearchFilter()
+{
+	if (SearchText.TrimStartAndEnd().IsEmpty())
+	{
+		DisplayedAssetsData = ListedAssetsData;
+	}
+	else if (bListingAllAssets)
+	{
+		// The index was built from StoredAssetsData, so its order already is the list order
+		DisplayedAssetsData = AssetSearchIndex.Search(SearchText);
+	}
+	else
+	{
+		const TSet<TSharedPtr<FAssetData>> MatchedAssetsData(AssetSearchIndex.Search(SearchText));
+		DisplayedAssetsData = ListedAssetsData.FilterByPredicate([&MatchedAssetsData](const TSharedPtr<FAssetData>& AssetData)
+			{
+				return MatchedAssetsData.Contains(AssetData);
+			}
+		);
 	}
 
+	SortDisplayedAssets();
 	RefreshAssetListView();
 }
 
 void SAdvanceDeletionWidget::RefreshAssetListView()
 {
-	AssetsDataToDeleteArray.Empty();
-	CheckBoxesArray.Empty();
 	if (ConstructedAssetListView.IsValid())
 	{
-		ConstructedAssetListView->RebuildList();
+		ConstructedAssetListView->RequestListRefresh();
 	}
 }
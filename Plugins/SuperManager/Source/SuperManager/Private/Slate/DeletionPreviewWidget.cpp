@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Slate/DeletionPreviewWidget.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/SWindow.h"
+
+void SDeletionPreviewWidget::Construct(const FArguments& InArgs)
+{
+	ParentWindow = InArgs._ParentWindow;
+	PreviewItems.Reserve(InArgs._SelectedAssetsData.Num() + InArgs._OrphanedAssetsData.Num());
+	for (const FAssetData& SelectedAssetData : InArgs._SelectedAssetsData)
+	{
+		PreviewItems.Add(MakeShared<FPreviewItem>(FPreviewItem{ SelectedAssetData, false }));
+	}
+	for (const FAssetData& OrphanedAssetData : InArgs._OrphanedAssetsData)
+	{
+		PreviewItems.Add(MakeShared<FPreviewItem>(FPreviewItem{ OrphanedAssetData, true }));
+	}
+
+	const FString SummaryText =
+		FString::FromInt(InArgs._SelectedAssetsData.Num()) + TEXT(" unused assets and the ") +
+		FString::FromInt(InArgs._OrphanedAssetsData.Num()) + TEXT(" dependencies nothing else references will be deleted, ") +
+		FText::AsMemory(InArgs._ReclaimableBytes).ToString() + TEXT(" on disk.");
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(5.0f)
+			[
+				SNew(STextBlock)
+					.Text(FText::FromString(SummaryText))
+					.AutoWrapText(true)
+			]
+
+			+SVerticalBox::Slot()
+			.VAlign(VAlign_Fill)
+			.Padding(5.0f)
+			[
+				SNew(SListView<TSharedPtr<FPreviewItem>>)
+					.ListItemsSource(&PreviewItems)
+					.OnGenerateRow(this, &SDeletionPreviewWidget::OnGenerateRowForList)
+			]
+
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Right)
+			.Padding(5.0f)
+			[
+				SNew(SHorizontalBox)
+					+SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					[
+						SNew(SButton)
+							.Text(FText::FromString(TEXT("Delete")))
+							.OnClicked(this, &SDeletionPreviewWidget::OnDeleteButtonClicked)
+					]
+					+SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					[
+						SNew(SButton)
+							.Text(FText::FromString(TEXT("Cancel")))
+							.OnClicked(this, &SDeletionPreviewWidget::OnCancelButtonClicked)
+					]
+			]
+	];
+}
+
+bool SDeletionPreviewWidget::ShowModal(const TArray<FAssetData>& SelectedAssetsData, const TArray<FAssetData>& OrphanedAssetsData, int64 ReclaimableBytes)
+{
+	TSharedRef<SWindow> PreviewWindow = SNew(SWindow)
+		.Title(FText::FromString(TEXT("Delete Unused Assets With Dependencies")))
+		.ClientSize(FVector2D(800.f, 600.f))
+		.SupportsMinimize(false)
+		.SupportsMaximize(false);
+
+	TSharedRef<SDeletionPreviewWidget> PreviewWidget = SNew(SDeletionPreviewWidget)
+		.SelectedAssetsData(SelectedAssetsData)
+		.OrphanedAssetsData(OrphanedAssetsData)
+		.ReclaimableBytes(ReclaimableBytes)
+		.ParentWindow(PreviewWindow);
+	PreviewWindow->SetContent(PreviewWidget);
+
+	FSlateApplication::Get().AddModalWindow(PreviewWindow, FSlateApplication::Get().GetActiveTopLevelWindow());
+	return PreviewWidget->IsConfirmed();
+}
+
+TSharedRef<ITableRow> SDeletionPreviewWidget::OnGenerateRowForList(
+	TSharedPtr<FPreviewItem> ItemToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable
+)
+{
+	return SNew(STableRow<TSharedPtr<FPreviewItem>>, OwnerTable)
+		.Padding(2.0f)
+		[
+			SNew(SHorizontalBox)
+				+SHorizontalBox::Slot()
+				.FillWidth(0.15f)
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(ItemToDisplay->bOrphaned ? TEXT("Orphaned") : TEXT("Selected")))
+				]
+				+SHorizontalBox::Slot()
+				.FillWidth(0.2f)
+				[
+					SNew(STextBlock)
+						.Text(FText::FromName(ItemToDisplay->AssetData.AssetClassPath.GetAssetName()))
+				]
+				+SHorizontalBox::Slot()
+				.FillWidth(0.65f)
+				[
+					SNew(STextBlock)
+						.Text(FText::FromName(ItemToDisplay->AssetData.PackageName))
+				]
+		];
+}
+
+FReply SDeletionPreviewWidget::OnDeleteButtonClicked()
+{
+	bConfirmed = true;
+	if (TSharedPtr<SWindow> PinnedWindow = ParentWindow.Pin())
+	{
+		PinnedWindow->RequestDestroyWindow();
+	}
+	return FReply::Handled();
+}
+
+FReply SDeletionPreviewWidget::OnCancelButtonClicked()
+{
+	bConfirmed = false;
+	if (TSharedPtr<SWindow> PinnedWindow = ParentWindow.Pin())
+	{
+		PinnedWindow->RequestDestroyWindow();
+	}
+	return FReply::Handled();
+}
@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Slate/NamingAuditWidget.h"
+#include "SuperManager.h"
+#include "EditorAssetLibrary.h"
+#include "AssetActions/AssetPrefixRenamer.h"
+#include "AssetActions/QuickAssetAction.h"
+#include "AssetAnalysis/AssetScanTask.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Layout/SBox.h"
+#include "DebugHeader.h"
+
+namespace ViolationListColumns
+{
+	const FName Class(TEXT("Class"));
+	const FName Name(TEXT("Name"));
+	const FName Path(TEXT("Path"));
+	const FName SuggestedName(TEXT("SuggestedName"));
+}
+
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateViolationCell, TSharedPtr<FAssetNamingViolation>, const FName&);
+
+class SNamingViolationRow : public SMultiColumnTableRow<TSharedPtr<FAssetNamingViolation>>
+{
+public:
+	SLATE_BEGIN_ARGS(SNamingViolationRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FAssetNamingViolation>, Violation)
+		SLATE_EVENT(FOnGenerateViolationCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		Violation = InArgs._Violation;
+		OnGenerateCell = InArgs._OnGenerateCell;
+		SMultiColumnTableRow<TSharedPtr<FAssetNamingViolation>>::Construct(
+			FSuperRowType::FArguments().Padding(2.0f),
+			OwnerTable
+		);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		return SNew(SBox)
+			.VAlign(VAlign_Center)
+			[
+				OnGenerateCell.Execute(Violation, ColumnName)
+			];
+	}
+
+private:
+	TSharedPtr<FAssetNamingViolation> Violation;
+	FOnGenerateViolationCell OnGenerateCell;
+};
+
+void SNamingAuditWidget::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+	FSlateFontInfo TitleTextFont = GetEmbossedTextFont();
+	TitleTextFont.Size = 30;
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+			// Title
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+					.Text(FText::FromString(TEXT("Naming Audit")))
+					.Font(TitleTextFont)
+					.Justification(ETextJustify::Center)
+					.ColorAndOpacity(FColor::White)
+			]
+
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(5.0f)
+			[
+				SNew(STextBlock)
+					.Text(this, &SNamingAuditWidget::GetSummaryText)
+					.Justification(ETextJustify::Center)
+					.AutoWrapText(true)
+			]
+
+			// for the violation list
+			+SVerticalBox::Slot()
+			.VAlign(VAlign_Fill)
+			[
+				ConstructViolationListView()
+			]
+
+			//for 2 buttons
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+					+SHorizontalBox::Slot()
+					.FillWidth(10.f)
+					.Padding(5.0f)
+					[
+						ConstructTabButton(TEXT("Run Audit"), FOnClicked::CreateSP(this, &SNamingAuditWidget::OnRunAuditButtonClicked))
+					]
+
+					+SHorizontalBox::Slot()
+					.FillWidth(10.f)
+					.Padding(5.0f)
+					[
+						ConstructTabButton(TEXT("Fix All"), FOnClicked::CreateSP(this, &SNamingAuditWidget::OnFixAllButtonClicked))
+					]
+			]
+	];
+
+	RunAudit();
+}
+
+TSharedRef<ITableRow> SNamingAuditWidget::OnGenerateRowForList(
+	TSharedPtr<FAssetNamingViolation> ViolationToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable
+)
+{
+	return SNew(SNamingViolationRow, OwnerTable)
+		.Violation(ViolationToDisplay)
+		.OnGenerateCell(this, &SNamingAuditWidget::ConstructCellForColumn);
+}
+
+TSharedRef<SWidget> SNamingAuditWidget::ConstructCellForColumn(TSharedPtr<FAssetNamingViolation> ViolationToDisplay, const FName& ColumnId)
+{
+	FString CellText;
+	if (ColumnId == ViolationListColumns::Class)
+	{
+		CellText = ViolationToDisplay->AssetData.AssetClassPath.GetAssetName().ToString();
+	}
+	else if (ColumnId == ViolationListColumns::Name)
+	{
+		CellText = ViolationToDisplay->AssetData.AssetName.ToString();
+	}
+	else if (ColumnId == ViolationListColumns::Path)
+	{
+		CellText = ViolationToDisplay->AssetData.PackagePath.ToString();
+	}
+	else if (ColumnId == ViolationListColumns::SuggestedName)
+	{
+		CellText = ViolationToDisplay->SuggestedName;
+	}
+
+	return SNew(STextBlock)
+		.Text(FText::FromString(CellText))
+		.ColorAndOpacity(FColor::White);
+}
+
+TSharedRef<SListView<TSharedPtr<FAssetNamingViolation>>> SNamingAuditWidget::ConstructViolationListView()
+{
+	ConstructedViolationListView = SNew(SListView<TSharedPtr<FAssetNamingViolation>>)
+		.ListItemsSource(&Violations)
+		.OnGenerateRow(this, &SNamingAuditWidget::OnGenerateRowForList)
+		.OnMouseButtonDoubleClick(this, &SNamingAuditWidget::OnRowClicked)
+		.HeaderRow(
+			SNew(SHeaderRow)
+			+ SHeaderRow::Column(ViolationListColumns::Class)
+				.DefaultLabel(FText::FromString(TEXT("Class")))
+				.FillWidth(0.15f)
+			+ SHeaderRow::Column(ViolationListColumns::Name)
+				.DefaultLabel(FText::FromString(TEXT("Name")))
+				.FillWidth(0.25f)
+			+ SHeaderRow::Column(ViolationListColumns::Path)
+				.DefaultLabel(FText::FromString(TEXT("Path")))
+				.FillWidth(0.35f)
+			+ SHeaderRow::Column(ViolationListColumns::SuggestedName)
+				.DefaultLabel(FText::FromString(TEXT("Suggested Name")))
+				.FillWidth(0.25f)
+		);
+
+	return ConstructedViolationListView.ToSharedRef();
+}
+
+TSharedRef<SButton> SNamingAuditWidget::ConstructTabButton(const FString& ButtonText, FOnClicked OnClicked)
+{
+	FSlateFontInfo ButtonTextFont = GetEmbossedTextFont();
+	ButtonTextFont.Size = 15.0f;
+	return SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(OnClicked)
+		.IsEnabled_Lambda([this]() { return !IsAuditInProgress(); })
+		[
+			SNew(STextBlock)
+				.Text(FText::FromString(ButtonText))
+				.Font(ButtonTextFont)
+				.Justification(ETextJustify::Center)
+		];
+}
+
+void SNamingAuditWidget::OnRowClicked(TSharedPtr<FAssetNamingViolation> Violation)
+{
+	TArray<FString> AssetPath;
+	AssetPath.Add(Violation->AssetData.GetObjectPathString());
+	UEditorAssetLibrary::SyncBrowserToObjects(AssetPath);
+}
+
+FReply SNamingAuditWidget::OnRunAuditButtonClicked()
+{
+	RunAudit();
+	return FReply::Handled();
+}
+
+FReply SNamingAuditWidget::OnFixAllButtonClicked()
+{
+	if (Violations.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No naming violations to fix"), false);
+		return FReply::Handled();
+	}
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(
+		EAppMsgType::YesNo,
+		TEXT("Rename ") + FString::FromInt(Violations.Num()) + TEXT(" assets to their suggested names?"),
+		false
+	);
+	if (ConfirmResult == EAppReturnType::No)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FAssetData> AssetsDataToRename;
+	AssetsDataToRename.Reserve(Violations.Num());
+	for (const TSharedPtr<FAssetNamingViolation>& Violation : Violations)
+	{
+		AssetsDataToRename.Add(Violation->AssetData);
+	}
+
+	// The audit runs again once the redirectors are fixed up, so whatever could not be renamed stays listed
+	bAuditInProgress = true;
+	FAssetPrefixRenamer PrefixRenamer(GetDefault<UQuickAssetAction>()->GetPrefixMap());
+	PrefixRenamer.AddPrefixes(AssetsDataToRename, FSimpleDelegate::CreateSP(this, &SNamingAuditWidget::RunAudit));
+	return FReply::Handled();
+}
+
+void SNamingAuditWidget::RunAudit()
+{
+	bAuditInProgress = true;
+	TSharedRef<TArray<FAssetNamingViolation>> FoundViolations = MakeShared<TArray<FAssetNamingViolation>>();
+	TWeakPtr<SNamingAuditWidget> WeakThis = StaticCastSharedRef<SNamingAuditWidget>(AsShared());
+
+	AuditScanTask = FAssetScanTask::Launch(
+		FText::FromString(TEXT("Naming audit")),
+		[PrefixMap = GetDefault<UQuickAssetAction>()->GetPrefixMap(), ContentRoots = FSuperManagerModule::GetProjectContentRoots(), FoundViolations](FAssetScanTask& ScanTask)
+		{
+			*FoundViolations = FAssetNamingAudit::Run(PrefixMap, ContentRoots, &ScanTask);
+		},
+		[WeakThis, FoundViolations]()
+		{
+			TSharedPtr<SNamingAuditWidget> PinnedThis = WeakThis.Pin();
+			if (!PinnedThis.IsValid())
+			{
+				return;
+			}
+
+			PinnedThis->Violations.Reset(FoundViolations->Num());
+			for (FAssetNamingViolation& FoundViolation : *FoundViolations)
+			{
+				PinnedThis->Violations.Add(MakeShared<FAssetNamingViolation>(MoveTemp(FoundViolation)));
+			}
+			PinnedThis->bAuditInProgress = false;
+			PinnedThis->ConstructedViolationListView->RequestListRefresh();
+		}
+	);
+}
+
+bool SNamingAuditWidget::IsAuditInProgress() const
+{
+	// A cancelled scan never reports back, so the task is asked as well
+	const bool bAuditCancelled = AuditScanTask.IsValid() && AuditScanTask->IsFinished() && AuditScanTask->IsCancelled();
+	return bAuditInProgress && !bAuditCancelled;
+}
+
+FText SNamingAuditWidget::GetSummaryText() const
+{
+	if (IsAuditInProgress())
+	{
+		return FText::FromString(TEXT("Checking asset names against the prefix rules..."));
+	}
+	return FText::FromString(FString::FromInt(Violations.Num()) +
+		TEXT(" assets do not follow the prefix rules. Double click to go to where an asset is located."));
+}
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Makes several copies of several assets in one go: names are resolved up front against the folders' existing assets,
+ * every copy is created in memory first, and the new packages are then saved in one pass whose file writes run in the background.
+ * The saved files are marked for add in source control together once the writes are done.
+ */
+class FAssetBatchDuplicator
+{
+public:
+	// Copies are named <Asset>_1.._N, skipping numbers already taken. Returns the number of copies saved.
+	static int32 DuplicateAssets(const TArray<FAssetData>& SourceAssetsData, int32 DuplicatesNum);
+
+private:
+	static TSet<FName> CollectTakenPackageNames(const TArray<FAssetData>& SourceAssetsData);
+	static int32 SaveNewPackages(const TArray<UPackage*>& NewPackages);
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Bulk deletion in bounded chunks with a garbage collection pass between them, so only one chunk of assets is loaded at a time.
+ * Large runs are journaled under Saved/SuperManager; a run that was interrupted is offered for resume once the registry has finished loading.
+ */
+class FAssetDeletionEngine
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	// Returns the number of assets deleted. Sets no larger than one chunk go straight to ObjectTools with its usual dialog.
+	int32 DeleteAssets(const TArray<FAssetData>& AssetsToDelete, bool bShowConfirmation = true);
+
+	bool HasInterruptedRun() const;
+	int32 ResumeInterruptedRun();
+
+private:
+	int32 RunChunkedDeletion(const TArray<FAssetData>& AssetsToDelete);
+	static TArray<TArray<FAssetData>> BuildChunksReferencersFirst(const TArray<FAssetData>& AssetsToDelete, int32 ChunkSize);
+	void OnAssetRegistryFilesLoaded();
+
+	static FString GetJournalFilePath();
+	static void AppendToJournal(const TCHAR* Prefix, const TArray<FAssetData>& AssetsData);
+	static TArray<FName> ReadPendingPackagesFromJournal();
+	static void DeleteJournal();
+
+	FTSTicker::FDelegateHandle ResumePromptTickerHandle;
+	bool bDeletionInProgress = false;
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Adds naming-convention prefixes from FAssetData alone, without loading the assets to find out their class.
+ * A class without its own prefix takes the one of its nearest ancestor that has one, looked up through the registry
+ * so Blueprint classes that are not loaded resolve as well. Every rename goes to IAssetTools in one batch.
+ */
+class FAssetPrefixRenamer
+{
+public:
+	explicit FAssetPrefixRenamer(const TMap<UObject*, FString>& PrefixMap);
+
+	// Null when neither the class nor any of its ancestors has a prefix
+	const FString* FindPrefix(const FTopLevelAssetPath& ClassPath);
+	FORCEINLINE const FString* FindPrefix(const FAssetData& AssetData)
+	{
+		return FindPrefix(AssetData.AssetClassPath);
+	}
+	bool IsMaterialInstanceClass(const FTopLevelAssetPath& ClassPath);
+	// The asset name with the prefix in front, material instances losing their M_ prefix and _Inst suffix first
+	FString GetPrefixedName(const FAssetData& AssetData, const FString& Prefix);
+	// Same as GetPrefixedName for a class already resolved; touches no cache, so it is safe on any thread
+	FString MakePrefixedName(const FString& AssetName, const FString& Prefix, bool bIsMaterialInstance) const;
+
+	// Renames the assets that are missing their prefix and fixes up the redirectors left behind once, then calls OnCompleted.
+	// Returns the number of assets renamed.
+	int32 AddPrefixes(const TArray<FAssetData>& AssetsData, FSimpleDelegate OnCompleted = FSimpleDelegate());
+
+private:
+	bool IsChildOf(const FTopLevelAssetPath& ClassPath, const FTopLevelAssetPath& ParentClassPath);
+	const TArray<FTopLevelAssetPath>& GetAncestorClassPaths(const FTopLevelAssetPath& ClassPath);
+
+	TMap<FTopLevelAssetPath, FString> PrefixByClassPath;
+	// Resolved prefix per asset class, null for classes without one
+	TMap<FTopLevelAssetPath, const FString*> ResolvedPrefixCache;
+	TMap<FTopLevelAssetPath, TArray<FTopLevelAssetPath>> AncestorClassPathCache;
+	FTopLevelAssetPath MaterialClassPath;
+	FTopLevelAssetPath MaterialInstanceConstantClassPath;
+};
@@ -31,6 +31,16 @@ public:
 	UFUNCTION(CallInEditor)
 	void RemoveUnusedAssets();
 
+	// Also deletes the dependencies that nothing else references once the unused assets are gone, after a preview
+	UFUNCTION(CallInEditor)
+	void RemoveUnusedAssetsWithDependencies();
+
+	// The project's naming rules, also used by the naming audit
+	FORCEINLINE const TMap<UObject*, FString>& GetPrefixMap() const
+	{
+		return PrefixMap;
+	}
+
 private:
 	TMap<UObject*, FString> PrefixMap =
 	{
@@ -50,5 +60,5 @@ private:
 		{UNiagaraEmitter::StaticClass(), TEXT("NE_")}
 	};
 
-	void FixUpRedirectors();
+	void RemoveUnusedAssetsFromList(const TArray<FAssetData>& SelectedAssetsData, bool bIncludeOrphanedDependencies = false);
 };
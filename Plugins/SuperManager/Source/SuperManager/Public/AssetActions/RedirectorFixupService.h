@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRedirectorReferencersFixedUp, const TArray<FName>& /*ReferencerPackageNames*/);
+
+/**
+ * Shared redirector fixup used by every delete path.
+ * Only redirectors connected to the requested scope are loaded, asynchronously and in batches,
+ * and the /Game redirector list is re-read only after the registry reports a redirector change.
+ */
+class FRedirectorFixupService
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	// Fix the redirectors that point at, are used by, or live under the given scope. OnCompleted always fires, immediately if there is nothing to fix.
+	void FixUpRedirectors(
+		const TSet<FName>& ScopePackageNames,
+		const TArray<FString>& ScopeFolderPaths,
+		FSimpleDelegate OnCompleted
+	);
+
+	FORCEINLINE FOnRedirectorReferencersFixedUp& OnReferencersFixedUp()
+	{
+		return ReferencersFixedUpDelegate;
+	}
+
+private:
+	struct FFixupRequest
+	{
+		TSet<FName> ScopePackageNames;
+		TArray<FString> ScopeFolderPaths;
+		FSimpleDelegate OnCompleted;
+	};
+
+	void StartNextRequest();
+	void LoadNextBatch();
+	void FinishCurrentRequest();
+	void RefreshRedirectorCache();
+	bool IsRedirectorInScope(const FAssetData& RedirectorData, const FFixupRequest& Request) const;
+	void OnRedirectorAssetChanged(const FAssetData& AssetData);
+	void OnRedirectorAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	TArray<FAssetData> CachedRedirectors;
+	bool bRedirectorCacheDirty = true;
+
+	TArray<FFixupRequest> PendingRequests;
+	bool bRequestInProgress = false;
+	TArray<FSoftObjectPath> RedirectorPathsToLoad;
+	TArray<FSoftObjectPath> LoadedRedirectorPaths;
+	TArray<FName> ReferencerPackageNames;
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+	FStreamableManager StreamableManager;
+
+	FOnRedirectorReferencersFixedUp ReferencersFixedUpDelegate;
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FAssetScanTask;
+
+/**
+ * Finds assets whose package payloads are byte-identical, e.g. the same texture imported twice under different names.
+ * The package header bytes are skipped since they hold the asset's own name, paths and GUIDs. The exports index into
+ * its name map and import table, so those are compared resolved to strings and in file order instead.
+ * Only packages of the same class, payload size, dependencies and resolved tables are hashed, streamed in parallel.
+ */
+class FAssetContentHasher
+{
+public:
+	// Groups of two or more assets with identical content, each group in the order the assets were given
+	static TArray<TArray<TSharedPtr<FAssetData>>> FindDuplicateContent(
+		const TArray<TSharedPtr<FAssetData>>& AssetsData,
+		FAssetScanTask* ScanTask = nullptr
+	);
+
+	// Byte-for-byte check behind a hash match, for when a wrong match cannot be undone
+	static bool HaveIdenticalContent(const FAssetData& AssetDataA, const FAssetData& AssetDataB);
+
+private:
+	static TArray<FName> GetSortedDependencies(FName PackageName);
+	static uint64 HashReferences(const TArray<FName>& SortedDependencies, const TArray<FString>& ResolvedTables);
+	static uint64 HashPayload(const FString& PackageFilename, int64 HeaderSize, TArray<uint8>& ReadBuffer);
+};
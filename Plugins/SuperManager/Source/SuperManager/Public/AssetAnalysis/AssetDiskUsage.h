@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bytes a package occupies on disk: the .uasset or .umap plus the .uexp, .ubulk and .uptnl files next to it.
+ * Read from the file system rather than the registry, so it is right for packages saved since the last scan.
+ */
+class FAssetDiskUsage
+{
+public:
+	static int64 GetPackageDiskSize(FName PackageName);
+	// Same, for a package already resolved to its .uasset or .umap
+	static int64 GetPackageFileSize(const FString& PackageFilename);
+	static TConstArrayView<const TCHAR*> GetSidecarExtensions();
+	// Stats all the packages in parallel
+	static int64 GetTotalDiskSize(const TSet<FName>& PackageNames);
+};
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** One predicate of an FAssetFilterPipeline. Matches is called from worker threads. */
+class FAssetFilterStage
+{
+public:
+	virtual ~FAssetFilterStage() = default;
+
+	// Cheaper stages are evaluated first so they can short-circuit the expensive ones
+	virtual int32 GetCost() const = 0;
+	virtual bool Matches(const FAssetData& AssetData) const = 0;
+};
+
+class FAssetClassFilterStage : public FAssetFilterStage
+{
+public:
+	explicit FAssetClassFilterStage(const TArray<FString>& ClassNames);
+
+	virtual int32 GetCost() const override { return 0; }
+	virtual bool Matches(const FAssetData& AssetData) const override;
+
+private:
+	TSet<FName> ClassNames;
+};
+
+class FAssetPackageSetFilterStage : public FAssetFilterStage
+{
+public:
+	explicit FAssetPackageSetFilterStage(TSet<FName>&& InPackageNames);
+
+	virtual int32 GetCost() const override { return 0; }
+	virtual bool Matches(const FAssetData& AssetData) const override;
+
+private:
+	TSet<FName> PackageNames;
+};
+
+class FAssetPathGlobFilterStage : public FAssetFilterStage
+{
+public:
+	// Wildcards as in FString::MatchesWildcard, matched against the package name
+	explicit FAssetPathGlobFilterStage(const FString& InPathGlob);
+
+	virtual int32 GetCost() const override { return 1; }
+	virtual bool Matches(const FAssetData& AssetData) const override;
+
+private:
+	FString PathGlob;
+};
+
+class FAssetTagValueFilterStage : public FAssetFilterStage
+{
+public:
+	// An empty value matches any asset that has the tag
+	FAssetTagValueFilterStage(FName InTagName, const FString& InTagValue);
+
+	virtual int32 GetCost() const override { return 2; }
+	virtual bool Matches(const FAssetData& AssetData) const override;
+
+private:
+	FName TagName;
+	FString TagValue;
+};
+
+class FAssetSizeRangeFilterStage : public FAssetFilterStage
+{
+public:
+	FAssetSizeRangeFilterStage(int64 InMinSize, int64 InMaxSize);
+
+	virtual int32 GetCost() const override { return 3; }
+	virtual bool Matches(const FAssetData& AssetData) const override;
+
+private:
+	int64 MinSize;
+	int64 MaxSize;
+};
+
+enum class EAssetFilterCombineMode : uint8
+{
+	MatchAll,
+	MatchAny
+};
+
+/**
+ * Stages combined with AND or OR, evaluated in one parallel pass over the assets.
+ * Each stage keeps its per-asset results, so replacing a stage only re-evaluates that stage,
+ * and a stage is never evaluated for an asset an earlier stage has already decided.
+ */
+class FAssetFilterPipeline
+{
+public:
+	void SetAssetsData(const TArray<TSharedPtr<FAssetData>>& InAssetsData);
+	// Drops the assets of these packages without throwing away the other results
+	void RemoveAssetsData(const TSet<FName>& PackageNames);
+
+	// Adds, replaces or (with a null stage) removes the stage in the given slot
+	void SetStage(FName SlotName, TSharedPtr<FAssetFilterStage> Stage);
+	void SetCombineMode(EAssetFilterCombineMode InCombineMode);
+
+	bool HasStages() const;
+
+	// Assets that pass, in the order they were given
+	TArray<TSharedPtr<FAssetData>> Evaluate();
+
+private:
+	enum EStageResult : uint8
+	{
+		Unknown,
+		Failed,
+		Passed
+	};
+
+	struct FStageState
+	{
+		FName SlotName;
+		TSharedRef<FAssetFilterStage> Stage;
+		TArray<uint8> Results;
+	};
+
+	TArray<TSharedPtr<FAssetData>> AssetsData;
+	TArray<FStageState> Stages;
+	EAssetFilterCombineMode CombineMode = EAssetFilterCombineMode::MatchAll;
+};
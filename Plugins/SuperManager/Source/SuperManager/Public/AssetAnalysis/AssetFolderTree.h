@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetScanTask;
+
+/**
+ * Folder tree under one content folder with bottom-up asset counts.
+ * Built from a single recursive registry query plus a single walk of the directory on disk,
+ * so folders the registry has never seen are part of the tree too.
+ */
+class FAssetFolderTree
+{
+public:
+	void Build(const FString& InRootFolderPath, FAssetScanTask* ScanTask = nullptr);
+
+	// Folders below the root with no assets or files anywhere beneath them, children before parents
+	TArray<FString> GetEmptyFoldersDeepestFirst() const;
+
+	FORCEINLINE bool IsRootEmpty() const
+	{
+		return Folders.Num() > 0 && Folders[0].ContentCount == 0;
+	}
+
+private:
+	struct FFolderNode
+	{
+		FString Path;
+		int32 ParentIndex = INDEX_NONE;
+		int32 Depth = 0;
+		int32 ContentCount = 0;
+	};
+
+	void WalkDiskFolders(const FString& RootDirectory);
+	int32 FindOrAddFolder(const FString& FolderPath);
+	void AccumulateContentCounts();
+
+	FString RootFolderPath;
+	TArray<FFolderNode> Folders;
+	TMap<FString, int32> FolderIndices;
+	int32 MaxDepth = 0;
+};
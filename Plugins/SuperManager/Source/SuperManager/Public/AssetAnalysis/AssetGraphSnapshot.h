@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetReferenceIndex;
+class FAssetScanTask;
+
+/**
+ * The dependency graph of an FAssetReferenceIndex persisted under Saved/, so that after a restart only the packages
+ * whose files changed since it was written are re-queried from the registry.
+ * The file is flat name, package and edge tables that are read in place through a memory mapping.
+ */
+class FAssetGraphSnapshot
+{
+public:
+	static FString GetDefaultFilePath();
+
+	static bool Save(const FAssetReferenceIndex& ReferenceIndex, const FString& FilePath);
+	// Fills the index and marks every package that changed, appeared or disappeared since the save as dirty
+	static bool Load(FAssetReferenceIndex& ReferenceIndex, const FString& FilePath, FAssetScanTask* ScanTask = nullptr);
+
+private:
+	// Ticks of the package file on disk, or 0 when it is gone
+	static int64 GetPackageTimestamp(FName PackageName, bool& bOutIsMap);
+	static int64 GetPackageTimestamp(FName PackageName, bool bIsMap);
+};
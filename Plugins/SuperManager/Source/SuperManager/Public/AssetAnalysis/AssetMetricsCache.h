@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetMetrics
+{
+	// -1 until the registry reports a size
+	int64 DiskSize = -1;
+	int32 ReferencerCount = 0;
+	int32 DependencyCount = 0;
+	FDateTime ModifiedTime;
+};
+
+/**
+ * Per-package cost metrics, computed on the thread pool the first time they are asked for.
+ * OnMetricsUpdated fires on the game thread each time the queue of requested packages has drained.
+ */
+class FAssetMetricsCache : public TSharedFromThis<FAssetMetricsCache>
+{
+public:
+	// Returns false and queues the package if its metrics are not cached yet
+	bool GetOrRequest(FName PackageName, FAssetMetrics& OutMetrics);
+	void Request(const TArray<FName>& PackageNames);
+	void Invalidate(FName PackageName);
+
+	FORCEINLINE FSimpleMulticastDelegate& OnMetricsUpdated()
+	{
+		return MetricsUpdatedDelegate;
+	}
+
+private:
+	void EnqueueLocked(FName PackageName);
+	void LaunchWorkerLocked();
+	void ProcessQueue();
+	static FAssetMetrics ComputeMetrics(FName PackageName);
+
+	FCriticalSection Lock;
+	TMap<FName, FAssetMetrics> CachedMetrics;
+	TSet<FName> QueuedPackages;
+	TArray<FName> PackageQueue;
+	bool bWorkerRunning = false;
+
+	FSimpleMulticastDelegate MetricsUpdatedDelegate;
+};
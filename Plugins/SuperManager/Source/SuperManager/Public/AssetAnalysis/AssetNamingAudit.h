@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FAssetScanTask;
+
+struct FAssetNamingViolation
+{
+	FAssetData AssetData;
+	FString ExpectedPrefix;
+	FString SuggestedName;
+};
+
+/**
+ * Checks every on-disk asset under the content roots against the naming-convention prefixes.
+ * Works from registry data only: classes are resolved once per class, the names are then checked in parallel.
+ */
+class FAssetNamingAudit
+{
+public:
+	static TArray<FAssetNamingViolation> Run(
+		const TMap<UObject*, FString>& PrefixMap,
+		const TArray<FString>& ContentRoots,
+		FAssetScanTask* ScanTask = nullptr,
+		bool bRecursivePaths = true
+	);
+};
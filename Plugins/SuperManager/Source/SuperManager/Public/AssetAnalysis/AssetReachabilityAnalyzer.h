@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetReferenceIndex;
+
+/**
+ * Mark-and-sweep over the dependency graph held by FAssetReferenceIndex.
+ * Anything that cannot be reached from the root set is unused, including
+ * islands of assets that only reference each other.
+ */
+class FAssetReachabilityAnalyzer
+{
+public:
+	static TSet<FName> FindUnreachablePackages(
+		const FAssetReferenceIndex& ReferenceIndex,
+		const TSet<FName>& RootPackages
+	);
+
+	// Dependencies of the given packages, direct or not, that nothing else keeps alive once they are gone, cycles included.
+	// Roots are never orphaned; dependencies still reachable from a package outside the removed set go to OutSharedDependencies.
+	static TSet<FName> FindOrphanedDependencies(
+		const FAssetReferenceIndex& ReferenceIndex,
+		const TSet<FName>& PackagesToRemove,
+		const TSet<FName>& RootPackages,
+		TSet<FName>* OutSharedDependencies = nullptr
+	);
+};
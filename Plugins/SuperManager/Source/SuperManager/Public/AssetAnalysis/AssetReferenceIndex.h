@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetScanTask;
+
+/**
+ * Reverse-dependency index over every on-disk package in the asset registry.
+ * Built once, then kept current by re-querying only the packages marked dirty since the last refresh.
+ * Packages may be marked dirty from any thread; building and refreshing belong to one thread at a time.
+ */
+class FAssetReferenceIndex
+{
+public:
+	void Build(FAssetScanTask* ScanTask = nullptr);
+	// Build from a graph that did not come from the registry, e.g. a synthetic benchmark project
+	void BuildFromDependencies(TMap<FName, TArray<FName>>&& InPackageDependencies);
+
+	// Re-query the packages marked dirty since the last refresh, or build from scratch if never built
+	void Refresh(FAssetScanTask* ScanTask = nullptr);
+	void MarkPackageDirty(FName PackageName);
+	void Reset();
+
+	bool HasNoReferencers(FName PackageName) const;
+	int32 GetReferencerCount(FName PackageName) const;
+
+	FORCEINLINE bool IsBuilt() const
+	{
+		return bBuilt;
+	}
+
+	// Bumped every time the graph changes, so derived results can be cached against it
+	FORCEINLINE uint32 GetVersion() const
+	{
+		return Version;
+	}
+
+	FORCEINLINE const TMap<FName, TArray<FName>>& GetPackageDependencies() const
+	{
+		return PackageDependencies;
+	}
+
+private:
+	void AddPackageEdges(FName PackageName, TArray<FName>&& Dependencies);
+	void RemovePackageEdges(FName PackageName);
+
+	TMap<FName, TArray<FName>> PackageDependencies;
+	TMap<FName, int32> ReferencerCounts;
+	TSet<FName> DirtyPackages;
+	FCriticalSection DirtyPackagesLock;
+	uint32 Version = 0;
+	bool bBuilt = false;
+};
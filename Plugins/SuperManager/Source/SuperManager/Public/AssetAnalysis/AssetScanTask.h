@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AsyncTaskNotification.h"
+#include "Async/Future.h"
+
+/**
+ * Runs registry-only work on the thread pool behind a progress notification with a cancel button.
+ * OnCompleted is called back on the game thread, where UObjects may be touched, unless the user cancelled.
+ */
+class FAssetScanTask : public TSharedFromThis<FAssetScanTask>
+{
+public:
+	static TSharedRef<FAssetScanTask> Launch(
+		const FText& Title,
+		TFunction<void(FAssetScanTask&)> BackgroundWork,
+		TFunction<void()> OnCompleted
+	);
+
+	// Safe to call from the worker
+	void SetProgress(int32 InCompletedCount, int32 InTotalCount);
+
+	// Blocks until the worker has returned; OnCompleted is never called afterwards
+	void CancelAndWait();
+
+	FORCEINLINE bool IsCancelled() const
+	{
+		return bCancelled;
+	}
+
+	FORCEINLINE bool IsFinished() const
+	{
+		return bFinished;
+	}
+
+private:
+	FAssetScanTask() = default;
+	bool Tick(float DeltaTime);
+
+	FText Title;
+	TFunction<void()> OnCompleted;
+	TUniquePtr<FAsyncTaskNotification> Notification;
+	TFuture<void> WorkFuture;
+
+	std::atomic<int32> CompletedCount = 0;
+	std::atomic<int32> TotalCount = 0;
+	std::atomic<bool> bCancelled = false;
+	std::atomic<bool> bWorkFinished = false;
+	bool bFinished = false;
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Case-insensitive trigram index over asset names and package paths.
+ * Package paths are indexed once per folder rather than once per asset, since many assets share a folder.
+ */
+class FAssetSearchIndex
+{
+public:
+	void Build(const TArray<TSharedPtr<FAssetData>>& InAssetsData);
+	void Reset();
+	// Drops the assets of these packages and renumbers the posting lists in place instead of rebuilding them
+	void RemoveAssetsData(const TSet<FName>& PackageNames);
+
+	// Substring match on the asset name or package path; a leading '^' matches prefixes instead. Results keep the build order.
+	TArray<TSharedPtr<FAssetData>> Search(const FString& Query) const;
+
+private:
+	typedef TMap<uint64, TArray<int32>> FTrigramPostings;
+
+	static void RemapEntries(TArray<int32>& EntryIndices, const TArray<int32>& NewEntryIndices);
+	static void AddTrigrams(const FString& LowerText, int32 EntryIndex, FTrigramPostings& Postings);
+	static void FindCandidates(const FString& LowerQuery, const FTrigramPostings& Postings, int32 NumEntries, TArray<int32>& OutCandidates);
+	static bool MatchesQuery(const FString& LowerText, const FString& LowerQuery, bool bPrefixMatch);
+
+	TArray<TSharedPtr<FAssetData>> AssetsData;
+	TArray<FString> LowerAssetNames;
+	TArray<FString> LowerPackagePaths;
+	TArray<TArray<int32>> PackagePathAssetIndices;
+	FTrigramPostings AssetNameTrigrams;
+	FTrigramPostings PackagePathTrigrams;
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetRegistry/AssetData.h"
+#include "SuperManagerBenchmarkCommandlet.generated.h"
+
+/**
+ * Times every SuperManager scan path and appends the results to a CSV.
+ *
+ * -run=SuperManagerBenchmark [-Sizes=10000+100000+1000000] [-Density=4] [-RootFraction=0.01]
+ *     [-SameNameFraction=0.1] [-Seed=1] [-Output=<file.csv>] [-IncludeFixup]
+ *
+ * Graph and list paths run on synthetic projects of each size; paths that only exist on top of
+ * the registry or the disk run once against the real project. -IncludeFixup also fixes up the
+ * project's redirectors, so it is off by default.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FSyntheticProject
+	{
+		TArray<FName> PackageNames;
+		TMap<FName, TArray<FName>> PackageDependencies;
+		TArray<TSharedPtr<FAssetData>> AssetsData;
+		TSet<FName> RootPackages;
+	};
+
+	static FSyntheticProject GenerateSyntheticProject(int32 NumPackages, float Density, float RootFraction, float SameNameFraction, int32 Seed);
+
+	void RunSyntheticBenchmarks(const FSyntheticProject& Project, float Density);
+	void RunProjectBenchmarks(bool bIncludeFixup);
+
+	// Times one path and appends a CSV row
+	void Measure(const TCHAR* PathName, int32 NumPackages, float Density, TFunctionRef<int32()> Body);
+
+	TArray<FString> CsvRows;
+};
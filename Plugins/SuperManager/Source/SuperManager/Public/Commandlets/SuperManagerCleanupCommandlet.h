@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetRegistry/AssetData.h"
+#include "SuperManagerCleanupCommandlet.generated.h"
+
+class FJsonObject;
+class FAssetReferenceIndex;
+
+/**
+ * Headless content hygiene report: unused assets, same-name assets, empty folders, redirectors and naming violations.
+ *
+ * -run=SuperManagerCleanup [-Roots=/Game+/MyPlugin] [-Report=<file.json>] [-Shards=<N>]
+ *
+ * With -Shards the folders below every mounted content root are split across N child processes.
+ * Each child gathers only its own folders and hands back their assets, package dependencies, empty folders,
+ * redirectors and naming violations. This process never scans the whole registry; it merges the dependencies
+ * into one graph and runs the unused and same-name passes over it.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerCleanupCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerCleanupCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void AddGraphSections(
+		const TSharedRef<FJsonObject>& Report,
+		const TArray<FString>& ContentRoots,
+		const TArray<FAssetData>& AllAssetsData,
+		const FAssetReferenceIndex& ReferenceIndex,
+		const TSet<FName>& RootPackages
+	);
+	// Without bRecursive only the assets sitting directly in the folders are checked and no folder tree is built
+	void AddFolderSections(const TSharedRef<FJsonObject>& Report, const TArray<FString>& Folders, bool bRecursive);
+	TArray<TArray<FString>> SplitIntoShards(int32 NumShards);
+	bool RunShards(
+		const TArray<TArray<FString>>& ShardFolders,
+		const TArray<FString>& ContentRoots,
+		const FString& ReportFilePath,
+		const TSharedRef<FJsonObject>& Report,
+		TArray<FAssetData>& OutAssetsData,
+		TMap<FName, TArray<FName>>& OutPackageDependencies
+	);
+	// Packages directly in a mounted root belong to no shard's folder
+	void AddLooseRootPackages(TArray<FAssetData>& AssetsData, TMap<FName, TArray<FName>>& PackageDependencies);
+	bool RunAsShard(const FString& ShardFolderListPath, const TArray<FString>& ContentRoots, const FString& ReportFilePath);
+
+	static TArray<FString> GetMountedContentRoots();
+	static bool IsUnderAnyContentRoot(const FString& PackagePath, const TArray<FString>& ContentRoots);
+	static bool SaveReport(const TSharedRef<FJsonObject>& Report, const FString& ReportFilePath);
+};
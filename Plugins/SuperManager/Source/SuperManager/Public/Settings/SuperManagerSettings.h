@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuperManagerSettings.generated.h"
+
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager"))
+class SUPERMANAGER_API USuperManagerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	virtual FName GetCategoryName() const override;
+
+#pragma region Reachability
+	// Every map asset is treated as used
+	UPROPERTY(config, EditAnywhere, Category = "Reachability")
+	bool bTreatMapsAsRoots = true;
+
+	// Every asset registered with the asset manager as a primary asset is treated as used
+	UPROPERTY(config, EditAnywhere, Category = "Reachability")
+	bool bTreatPrimaryAssetsAsRoots = true;
+
+	// Directories to always cook from the packaging settings are treated as used
+	UPROPERTY(config, EditAnywhere, Category = "Reachability")
+	bool bTreatAlwaysCookDirectoriesAsRoots = true;
+
+	UPROPERTY(config, EditAnywhere, Category = "Reachability", meta = (LongPackageName))
+	TArray<FDirectoryPath> AdditionalRootDirectories;
+#pragma endregion
+
+#pragma region SameName
+	// Stripped before names are compared when listing similar names, e.g. T_Rock and Rock_01
+	UPROPERTY(config, EditAnywhere, Category = "Same Name")
+	TArray<FString> SimilarNameIgnoredPrefixes =
+	{
+		TEXT("BP_"), TEXT("SM_"), TEXT("SK_"), TEXT("M_"), TEXT("MI_"), TEXT("MF_"), TEXT("PS_"),
+		TEXT("SC_"), TEXT("SW_"), TEXT("T_"), TEXT("WBP_"), TEXT("NS_"), TEXT("NE_")
+	};
+#pragma endregion
+
+#pragma region Deletion
+	// Assets loaded and deleted per chunk before garbage is collected
+	UPROPERTY(config, EditAnywhere, Category = "Deletion", meta = (ClampMin = "1"))
+	int32 DeletionChunkSize = 256;
+#pragma endregion
+};
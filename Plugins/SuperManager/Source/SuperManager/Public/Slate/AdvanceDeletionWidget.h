@@ -2,6 +2,10 @@
 
 #pragma once
 #include "Widgets/SCompoundWidget.h"
+#include "AssetAnalysis/AssetSearchIndex.h"
+#include "AssetAnalysis/AssetMetricsCache.h"
+#include "AssetAnalysis/AssetFilterPipeline.h"
+#include "Widgets/Views/SHeaderRow.h"
 
 class SAdvanceDeletionWidget : public SCompoundWidget
 {
@@ -11,13 +15,22 @@ class SAdvanceDeletionWidget : public SCompoundWidget
 
 public:
 	void Construct(const FArguments& InArgs);
+	void SetAssetsData(const TArray<TSharedPtr<FAssetData>>& AssetsDataToStore);
 
 private:
 	TSharedRef<ITableRow> OnGenerateRowForList(
 		TSharedPtr<FAssetData> AssetDataToDisplay,
 		const TSharedRef<STableViewBase>& OwnerTable
 	);
+	TSharedRef<SWidget> ConstructCellForColumn(TSharedPtr<FAssetData> AssetDataToDisplay, const FName& ColumnId);
+	FText GetMetricText(TSharedPtr<FAssetData> AssetData, FName ColumnId) const;
 	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructAssetListView();
+	SHeaderRow::FColumn::FArguments ConstructSortableColumn(const FName& ColumnId, const FString& Label, float FillWidth);
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+	void OnAssetMetricsUpdated();
+	static bool IsMetricColumn(FName ColumnId);
+	void SortDisplayedAssets();
 	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay);
 	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
 	TSharedRef<SButton> ConstructButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisply);
@@ -26,25 +39,58 @@ private:
 	TSharedRef<SButton> ConstructDeleteAllButton();
 	TSharedRef<SButton> ConstructSelectAllButton();
 	TSharedRef<SButton> ConstructDeselectAllButton();
+	TSharedRef<SButton> ConstructInvertSelectionButton();
+	TSharedRef<SButton> ConstructConsolidateButton();
 	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructComboBox();
+	TSharedRef<SWidget> ConstructFilterBar();
+	TSharedRef<SWidget> ConstructFilterTextBox(FName SlotName, const FString& Label, const FString& HintText);
 	TSharedRef<STextBlock> ConstructHelpTextBlock(const FString& HelpText, ETextJustify::Type TextJustify);
 	void OnCheckBoxStateChange(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+	ECheckBoxState GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const;
 	void OnRowClicked(TSharedPtr<FAssetData> AssetData);
 	FReply OnDeleteButtonClicked(const TSharedPtr<FAssetData>& AssetDataToDisply);
 	FReply OnDeleteAllButtonClicked();
+	void DeleteSingleAsset(TSharedPtr<FAssetData> AssetDataToDelete);
+	void DeleteSelectedAssets();
+	void RemoveDeletedAssetsFromLists(const TSet<FName>& CandidatePackageNames);
 	FReply OnSelectAllButtonClicked();
 	FReply OnDeselectAllButtonClicked();
+	FReply OnInvertSelectionButtonClicked();
+	FReply OnConsolidateButtonClicked();
+	void ConsolidateDuplicateGroups(const TArray<TArray<TSharedPtr<FAssetData>>>& VerifiedGroups);
+	void OnDuplicatesConsolidated(TSet<FName> ConsolidatedPackageNames);
+	void ListDuplicateContentAssets();
 	TSharedRef<SWidget> OnGenerateComboContent(TSharedPtr<FString> SourceItem);
 	void OnComboSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo);
+	void OnFilterTextCommitted(const FText& InFilterText, ETextCommit::Type CommitType, FName SlotName);
+	static TSharedPtr<FAssetFilterStage> MakeFilterStage(FName SlotName, const FString& FilterText);
+	void SetPresetStage(const TArray<TSharedPtr<FAssetData>>& PresetAssetsData);
+	void ApplyFilterPipeline();
+	void OnSearchTextChanged(const FText& InSearchText);
+	void ApplySearchFilter();
 	void RefreshAssetListView();
 
 	TArray<TSharedPtr<FAssetData>> StoredAssetsData;
+	// Filter pipeline result, narrowed by the search text into DisplayedAssetsData
+	TArray<TSharedPtr<FAssetData>> ListedAssetsData;
 	TArray<TSharedPtr<FAssetData>> DisplayedAssetsData;
-	TArray<TSharedPtr<FAssetData>> AssetsDataToDeleteArray;
-	TArray<TSharedRef<SCheckBox>> CheckBoxesArray;
+	TSet<TSharedPtr<FAssetData>> AssetsDataToDeleteSet;
 	TArray<TSharedPtr<FString>> ComboBoxSourceItems;
 	TSharedPtr<SListView<TSharedPtr<FAssetData>>> ConstructedAssetListView;
 	TSharedPtr<STextBlock> ComboDisplayTextBlock;
+	FAssetFilterPipeline AssetFilterPipeline;
+	// Grouped presets (same name, duplicate content) keep their group order in the list
+	TMap<TSharedPtr<FAssetData>, int32> PresetListOrder;
+	FAssetSearchIndex AssetSearchIndex;
+	FString SearchText;
+	bool bListingAllAssets = true;
+	bool bListingDuplicateContent = false;
+	TArray<TArray<TSharedPtr<FAssetData>>> DuplicateContentGroups;
+	TSharedPtr<FAssetMetricsCache> AssetMetricsCache;
+	FName SortColumnId;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+	FSlateFontInfo AssetClassNameFont;
+	FSlateFontInfo AssetNameFont;
 
 
 	FORCEINLINE FSlateFontInfo GetEmbossedTextFont() const
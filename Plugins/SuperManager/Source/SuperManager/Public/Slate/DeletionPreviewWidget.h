@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "Widgets/SCompoundWidget.h"
+#include "AssetRegistry/AssetData.h"
+
+/** Modal list of everything a cascade delete would remove, with the selected assets first and what they orphan after. */
+class SDeletionPreviewWidget : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SDeletionPreviewWidget) {}
+		SLATE_ARGUMENT(TArray<FAssetData>, SelectedAssetsData)
+		SLATE_ARGUMENT(TArray<FAssetData>, OrphanedAssetsData)
+		SLATE_ARGUMENT(int64, ReclaimableBytes)
+		SLATE_ARGUMENT(TWeakPtr<SWindow>, ParentWindow)
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+	// Blocks until the window is closed; true when the user chose to delete
+	static bool ShowModal(const TArray<FAssetData>& SelectedAssetsData, const TArray<FAssetData>& OrphanedAssetsData, int64 ReclaimableBytes);
+
+	FORCEINLINE bool IsConfirmed() const
+	{
+		return bConfirmed;
+	}
+
+private:
+	struct FPreviewItem
+	{
+		FAssetData AssetData;
+		bool bOrphaned;
+	};
+
+	TSharedRef<ITableRow> OnGenerateRowForList(
+		TSharedPtr<FPreviewItem> ItemToDisplay,
+		const TSharedRef<STableViewBase>& OwnerTable
+	);
+	FReply OnDeleteButtonClicked();
+	FReply OnCancelButtonClicked();
+
+	TArray<TSharedPtr<FPreviewItem>> PreviewItems;
+	TWeakPtr<SWindow> ParentWindow;
+	bool bConfirmed = false;
+};
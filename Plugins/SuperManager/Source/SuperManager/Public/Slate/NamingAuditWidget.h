@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "Widgets/SCompoundWidget.h"
+#include "AssetAnalysis/AssetNamingAudit.h"
+
+class SNamingAuditWidget : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SNamingAuditWidget) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+private:
+	TSharedRef<ITableRow> OnGenerateRowForList(
+		TSharedPtr<FAssetNamingViolation> ViolationToDisplay,
+		const TSharedRef<STableViewBase>& OwnerTable
+	);
+	TSharedRef<SWidget> ConstructCellForColumn(TSharedPtr<FAssetNamingViolation> ViolationToDisplay, const FName& ColumnId);
+	TSharedRef<SListView<TSharedPtr<FAssetNamingViolation>>> ConstructViolationListView();
+	TSharedRef<SButton> ConstructTabButton(const FString& ButtonText, FOnClicked OnClicked);
+	void OnRowClicked(TSharedPtr<FAssetNamingViolation> Violation);
+	FReply OnRunAuditButtonClicked();
+	FReply OnFixAllButtonClicked();
+	void RunAudit();
+	FText GetSummaryText() const;
+	bool IsAuditInProgress() const;
+
+	TArray<TSharedPtr<FAssetNamingViolation>> Violations;
+	TSharedPtr<SListView<TSharedPtr<FAssetNamingViolation>>> ConstructedViolationListView;
+	TSharedPtr<FAssetScanTask> AuditScanTask;
+	bool bAuditInProgress = false;
+
+
+	FORCEINLINE FSlateFontInfo GetEmbossedTextFont() const
+	{
+		return FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	}
+};